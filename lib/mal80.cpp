@@ -0,0 +1,262 @@
+// lib/mal80.cpp
+// libmal80 — C ABI over the emulator core.  See mal80.h.
+//
+// Each step is a CoreStep, as in mal-80 and divergence_bisect: loader hooks
+// and host intercepts, else one instruction and IM 1 interrupt delivery.
+// No exception may cross the C boundary; the few core calls that throw
+// (ROM loading) are caught here.
+//
+// Built with -fvisibility=hidden so the shared library exports only the
+// mal80_* functions, not the C++ core.
+#pragma GCC visibility push(default)
+#include "mal80.h"
+#pragma GCC visibility pop
+#include "../src/cpu/z80.hpp"
+#include "../src/cpu/Coverage.hpp"
+#include "../src/system/Bus.hpp"
+#include "../src/fdc/FastDisk.hpp"
+#include "../src/SoftwareLoader.hpp"
+#include "../src/KeyInjector.hpp"
+#include "../src/FloatHLE.hpp"
+#include "../src/VideoHLE.hpp"
+#include "../src/CoreStep.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <new>
+
+struct mal80_machine {
+    Bus            bus;          // must precede cpu (Z80 holds a reference)
+    Z80            cpu;
+    SoftwareLoader loader;
+    KeyInjector    injector;
+    FloatHLE       fp;
+    VideoHLE       video;
+    FastDisk       fast_disk;
+    CoreStep       core{cpu, bus, injector, fp, video, fast_disk, &loader};
+    uint8_t        keys[8]{};
+    uint64_t       t_states = 0;
+    Coverage       coverage;
+
+    mal80_machine() : cpu(bus) { bus.set_keyboard_matrix(keys); }
+};
+
+struct mal80_snapshot {
+    Z80::State cpu;
+    Bus::State bus;
+    FloatHLE   fp;
+    VideoHLE   video;
+    FastDisk   fast_disk;
+    uint64_t   t_states;
+};
+
+// ============================================================================
+// STEP
+// ============================================================================
+// One instruction (or host-side intercept).  Returns T-states consumed.
+static uint64_t step(mal80_machine* m) {
+    uint64_t ts = 0;
+    m->core.step(ts);
+    m->t_states += ts;
+    return ts;
+}
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+extern "C" {
+
+int mal80_api_version(void) { return MAL80_API_VERSION; }
+
+mal80_machine* mal80_create(const uint8_t* rom, size_t rom_size) {
+    try {
+        auto* m = new mal80_machine;
+        if (rom && rom_size) m->bus.load_rom(rom, rom_size);
+        m->fp.attach(m->bus);
+        m->video.attach(m->bus);
+        m->cpu.reset();
+        return m;
+    } catch (const std::exception& e) {
+        std::cerr << "[MAL80] create failed: " << e.what() << "\n";
+        return nullptr;
+    }
+}
+
+void mal80_destroy(mal80_machine* m) { delete m; }
+
+void mal80_reset(mal80_machine* m) {
+    m->bus.hard_reset();
+    m->cpu.reset();
+    m->injector.clear();
+    m->t_states = 0;
+}
+
+// ============================================================================
+// RUNNING
+// ============================================================================
+uint64_t mal80_run(mal80_machine* m, uint64_t t_states) {
+    uint64_t done = 0;
+    while (done < t_states) done += step(m);
+    return done;
+}
+
+int mal80_run_until_pc(mal80_machine* m, uint16_t pc, uint64_t max_t_states) {
+    uint64_t done = 0;
+    while (true) {
+        if (m->cpu.get_pc() == pc) return 1;
+        if (done >= max_t_states) return 0;
+        done += step(m);
+    }
+}
+
+int mal80_run_until(mal80_machine* m, mal80_predicate pred, void* user,
+                    uint64_t max_t_states) {
+    uint64_t done = 0;
+    while (true) {
+        if (pred(m, user)) return 1;
+        if (done >= max_t_states) return 0;
+        done += step(m);
+    }
+}
+
+uint64_t mal80_t_states(const mal80_machine* m) { return m->t_states; }
+
+int mal80_set_option(mal80_machine* m, int option, int on) {
+    switch (option) {
+    case MAL80_OPT_FAST_DISK:
+        m->fast_disk.set_enabled(on != 0);
+        return 1;
+    case MAL80_OPT_FP_HLE:
+        m->fp.set_mode(on ? FloatHLE::Mode::ON : FloatHLE::Mode::OFF);
+        return 1;
+    case MAL80_OPT_VIDEO_HLE:
+        m->video.set_mode(on ? VideoHLE::Mode::ON : VideoHLE::Mode::OFF);
+        return 1;
+    case MAL80_OPT_FDC_ACCURATE:
+        m->bus.fdc().set_timing(on ? FDC::Timing::ACCURATE : FDC::Timing::ZERO_LATENCY);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// ============================================================================
+// CPU
+// ============================================================================
+void mal80_get_regs(const mal80_machine* m, mal80_regs* out) {
+    Z80::State s = m->cpu.save_state();
+    out->af  = static_cast<uint16_t>(s.reg.a << 8 | s.reg.f);
+    out->bc  = s.reg.bc;   out->de  = s.reg.de;   out->hl  = s.reg.hl;
+    out->af2 = static_cast<uint16_t>(s.reg.a2 << 8 | s.reg.f2);
+    out->bc2 = s.reg.bc2;  out->de2 = s.reg.de2;  out->hl2 = s.reg.hl2;
+    out->ix  = s.reg.ix;   out->iy  = s.reg.iy;
+    out->sp  = s.reg.sp;   out->pc  = s.reg.pc;
+    out->i   = s.reg.i;    out->r   = s.reg.r;    out->im = s.reg.im;
+    out->iff1   = s.reg.iff1;
+    out->iff2   = s.reg.iff2;
+    out->halted = s.reg.halted;
+}
+
+void mal80_set_regs(mal80_machine* m, const mal80_regs* in) {
+    Z80::State s = m->cpu.save_state();
+    s.reg.a  = static_cast<uint8_t>(in->af >> 8);   s.reg.f  = static_cast<uint8_t>(in->af);
+    s.reg.bc = in->bc;   s.reg.de = in->de;   s.reg.hl = in->hl;
+    s.reg.a2 = static_cast<uint8_t>(in->af2 >> 8);  s.reg.f2 = static_cast<uint8_t>(in->af2);
+    s.reg.bc2 = in->bc2; s.reg.de2 = in->de2; s.reg.hl2 = in->hl2;
+    s.reg.ix = in->ix;   s.reg.iy = in->iy;
+    s.reg.sp = in->sp;   s.reg.pc = in->pc;
+    s.reg.i  = in->i;    s.reg.r  = in->r;    s.reg.im = in->im;
+    s.reg.iff1   = in->iff1 != 0;
+    s.reg.iff2   = in->iff2 != 0;
+    s.reg.halted = in->halted != 0;
+    m->cpu.load_state(s);
+}
+
+// ============================================================================
+// MEMORY, KEYBOARD, SCREEN
+// ============================================================================
+uint8_t mal80_peek(const mal80_machine* m, uint16_t addr) { return m->bus.peek(addr); }
+
+void mal80_poke(mal80_machine* m, uint16_t addr, uint8_t val) { m->bus.write(addr, val); }
+
+void mal80_load(mal80_machine* m, uint16_t addr, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        m->bus.write(static_cast<uint16_t>(addr + i), data[i]);
+}
+
+void mal80_read_vram(const mal80_machine* m, uint8_t out[MAL80_VRAM_SIZE]) {
+    for (uint16_t i = 0; i < MAL80_VRAM_SIZE; i++) out[i] = m->bus.get_vram_byte(i);
+}
+
+void mal80_set_keys(mal80_machine* m, const uint8_t rows[8]) {
+    std::memcpy(m->keys, rows, sizeof(m->keys));
+}
+
+size_t mal80_type_text(mal80_machine* m, const char* text) {
+    m->injector.enqueue(text);
+    return m->injector.pending();
+}
+
+// ============================================================================
+// MEDIA
+// ============================================================================
+int mal80_mount_disk(mal80_machine* m, int drive, const uint8_t* data, size_t size,
+                     const char* name) {
+    std::vector<uint8_t> bytes(data, data + size);
+    return m->bus.fdc().load_disk_bytes(drive, std::move(bytes), name ? name : "(memory)");
+}
+
+int mal80_mount_disk_file(mal80_machine* m, int drive, const char* path) {
+    return m->bus.load_disk(drive, path);
+}
+
+size_t mal80_disk_image(const mal80_machine* m, int drive, uint8_t* out, size_t cap) {
+    // fdc() is non-const only because FastDisk drives it; this is a read.
+    std::vector<uint8_t> img = const_cast<mal80_machine*>(m)->bus.fdc().image_bytes(drive);
+    if (out && img.size() <= cap) std::copy(img.begin(), img.end(), out);
+    return img.size();
+}
+
+int mal80_load_cmd(mal80_machine* m, const char* path) {
+    return m->loader.load_cmd_file(path, m->bus, m->cpu);
+}
+
+// ============================================================================
+// SNAPSHOTS
+// ============================================================================
+mal80_snapshot* mal80_snapshot_save(const mal80_machine* m) {
+    auto* s = new (std::nothrow) mal80_snapshot;
+    if (!s) return nullptr;
+    s->cpu = m->cpu.save_state();
+    m->bus.save_state(s->bus);
+    s->fp        = m->fp;
+    s->video     = m->video;
+    s->fast_disk = m->fast_disk;
+    s->t_states  = m->t_states;
+    return s;
+}
+
+void mal80_snapshot_restore(mal80_machine* m, const mal80_snapshot* s) {
+    m->cpu.load_state(s->cpu);
+    m->bus.load_state(s->bus);
+    m->fp        = s->fp;
+    m->video     = s->video;
+    m->fast_disk = s->fast_disk;
+    m->t_states  = s->t_states;
+}
+
+void mal80_snapshot_free(mal80_snapshot* s) { delete s; }
+
+// ============================================================================
+// COVERAGE
+// ============================================================================
+void mal80_coverage_enable(mal80_machine* m, int on) {
+    m->cpu.set_coverage(on ? &m->coverage : nullptr);
+}
+
+int mal80_coverage_merge(const mal80_machine* m, const char* path) {
+    return m->coverage.merge_into(path);
+}
+
+}  // extern "C"
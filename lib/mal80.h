@@ -0,0 +1,167 @@
+/* lib/mal80.h
+ * libmal80 — the Mal-80 core (Z80, Bus, FDC, software loader) as an
+ * in-process library with a C ABI.  No SDL: no window, no audio, no pacing.
+ * A machine runs only when told to, as fast as the host allows.
+ *
+ * Typical harness:
+ *
+ *     mal80_machine* m = mal80_create(rom, rom_len);
+ *     mal80_mount_disk(m, 0, img, img_len, "boot.dsk");
+ *     mal80_run_until_pc(m, 0x402D, 50 * 1774080);   // DOS ready
+ *     mal80_snapshot* ready = mal80_snapshot_save(m);
+ *     for each case:
+ *         mal80_snapshot_restore(m, ready);
+ *         mal80_type_text(m, "DIR\n");
+ *         mal80_run(m, 2 * 1774080);
+ *         mal80_read_vram(m, screen);
+ *     mal80_snapshot_free(ready);
+ *     mal80_destroy(m);
+ *
+ * Machines are independent; different machines may run on different
+ * threads.  A single machine is not thread-safe.
+ *
+ * ABI: functions are only added, never changed; mal80_api_version()
+ * reports the version of the library actually linked.
+ */
+#ifndef MAL80_H
+#define MAL80_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAL80_API_VERSION 3
+
+/* Z80 clock: T-states per second and per 60 Hz frame. */
+#define MAL80_CLOCK_HZ        1774080
+#define MAL80_T_STATES_FRAME  29498
+
+#define MAL80_VRAM_SIZE 1024   /* 64 × 16 characters at 0x3C00 */
+
+typedef struct mal80_machine  mal80_machine;
+typedef struct mal80_snapshot mal80_snapshot;
+
+typedef struct mal80_regs {
+    uint16_t af, bc, de, hl;
+    uint16_t af2, bc2, de2, hl2;
+    uint16_t ix, iy, sp, pc;
+    uint8_t  i, r, im;
+    uint8_t  iff1, iff2, halted;
+} mal80_regs;
+
+/* Returns MAL80_API_VERSION of the library actually linked. */
+int mal80_api_version(void);
+
+/* ---- Lifetime -------------------------------------------------------- */
+
+/* New machine at power-on.  `rom` (up to 12KB) may be NULL for a machine
+ * with an empty ROM, e.g. to run raw code poked into RAM.  NULL on error. */
+mal80_machine* mal80_create(const uint8_t* rom, size_t rom_size);
+void           mal80_destroy(mal80_machine* m);
+
+/* Power cycle: clears RAM and CPU state, keeps ROM and mounted disks. */
+void mal80_reset(mal80_machine* m);
+
+/* ---- Running --------------------------------------------------------- */
+
+/* Predicate polled before every instruction; nonzero stops the run. */
+typedef int (*mal80_predicate)(mal80_machine* m, void* user);
+
+/* Run at least `t_states` T-states (whole instructions).  Returns the
+ * T-states actually executed. */
+uint64_t mal80_run(mal80_machine* m, uint64_t t_states);
+
+/* Run until PC == `pc` (checked before each instruction, including the
+ * first) or `max_t_states` have passed.  Returns 1 if the PC was reached. */
+int mal80_run_until_pc(mal80_machine* m, uint16_t pc, uint64_t max_t_states);
+
+/* Run until `pred` returns nonzero or `max_t_states` have passed.
+ * Returns 1 if the predicate fired. */
+int mal80_run_until(mal80_machine* m, mal80_predicate pred, void* user,
+                    uint64_t max_t_states);
+
+/* T-states executed since create/reset (or as restored by a snapshot). */
+uint64_t mal80_t_states(const mal80_machine* m);
+
+/* Options: the mal-80 switches that change how the core steps, all off
+ * by default.  A machine with the same options runs exactly as mal-80
+ * does.  (API version 3) */
+#define MAL80_OPT_FAST_DISK     1   /* --fast-disk: sector copy loops in one step */
+#define MAL80_OPT_FP_HLE        2   /* --fp-hle on: native FADD/FMULT/FDIV */
+#define MAL80_OPT_VIDEO_HLE     3   /* --video-hle on: native $DSP */
+#define MAL80_OPT_FDC_ACCURATE  4   /* --fdc-timing accurate */
+
+/* Turn `option` on (1) or off (0).  Returns 0 for an unknown option. */
+int mal80_set_option(mal80_machine* m, int option, int on);
+
+/* ---- CPU ------------------------------------------------------------- */
+
+void mal80_get_regs(const mal80_machine* m, mal80_regs* out);
+void mal80_set_regs(mal80_machine* m, const mal80_regs* in);
+
+/* ---- Memory, keyboard, screen ----------------------------------------- */
+
+/* Side-effect-free read of the address space as the CPU sees it. */
+uint8_t mal80_peek(const mal80_machine* m, uint16_t addr);
+/* Write as the CPU would (ROM area writes land in the shadow RAM). */
+void    mal80_poke(mal80_machine* m, uint16_t addr, uint8_t val);
+void    mal80_load(mal80_machine* m, uint16_t addr, const uint8_t* data, size_t len);
+
+/* Copy the 1024 bytes of video RAM. */
+void mal80_read_vram(const mal80_machine* m, uint8_t out[MAL80_VRAM_SIZE]);
+
+/* Set the 8-row keyboard matrix (row n = address 0x3801 << n; a set bit is
+ * a held key).  Stays in effect until changed. */
+void mal80_set_keys(mal80_machine* m, const uint8_t rows[8]);
+
+/* Queue text to be typed through the ROM keyboard routine ($KEY, 0x0049),
+ * one character per call of the routine.  '\n' is ENTER.  Returns the
+ * number of characters still queued after adding. */
+size_t mal80_type_text(mal80_machine* m, const char* text);
+
+/* ---- Media ------------------------------------------------------------ */
+
+/* Mount a JV1/JV3/IMD image from memory on drive 0-3 (copied).  `name` is
+ * informational.  Returns 1 on success. */
+int mal80_mount_disk(mal80_machine* m, int drive, const uint8_t* data, size_t size,
+                     const char* name);
+/* Mount from a file path (zip-transparent, directories as host disks). */
+int mal80_mount_disk_file(mal80_machine* m, int drive, const char* path);
+
+/* Serialise the drive's current image (including writes) into `out` when
+ * it fits.  Returns the full image size; 0 if the drive is empty. */
+size_t mal80_disk_image(const mal80_machine* m, int drive, uint8_t* out, size_t cap);
+
+/* Load a /CMD program into RAM and set PC to its entry point.  RST 28h
+ * overlay requests are then served from the same file's directory/zip.
+ * Returns 1 on success. */
+int mal80_load_cmd(mal80_machine* m, const char* path);
+
+/* ---- Snapshots --------------------------------------------------------- */
+
+/* Full machine state (CPU, memory, timing, disk controller) — not disk
+ * image contents or queued text.  Restore into the machine it came from,
+ * or any machine with the same ROM and media. */
+mal80_snapshot* mal80_snapshot_save(const mal80_machine* m);
+void            mal80_snapshot_restore(mal80_machine* m, const mal80_snapshot* s);
+void            mal80_snapshot_free(mal80_snapshot* s);
+
+/* ---- Coverage ---------------------------------------------------------- */
+
+/* Start (on = 1) or pause (0) recording the Z80 code executed: instruction
+ * starts and taken/not-taken conditional branches.  What was recorded is
+ * kept across pauses, resets and snapshot restores. */
+void mal80_coverage_enable(mal80_machine* m, int on);
+/* OR everything recorded into the coverage file at `path` (created if
+ * missing) under an exclusive lock, so many machines and processes can
+ * share one file.  Read it with coverage_report.  Returns 1 on success. */
+int  mal80_coverage_merge(const mal80_machine* m, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAL80_H */
@@ -0,0 +1,170 @@
+#include "BootCache.hpp"
+#include "cpu/z80.hpp"
+#include "system/Bus.hpp"
+#include "system/Fnv1a.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Z80::State>, "Z80::State is dumped raw");
+static_assert(std::is_trivially_copyable_v<Bus::State>, "Bus::State is dumped raw");
+
+static constexpr char     CACHE_DIR[] = "bootcache";
+static constexpr char     MAGIC[8]    = {'M', 'A', 'L', '8', '0', 'B', 'C', '1'};
+static constexpr uint32_t VERSION     = 1;
+
+namespace {
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t cpu_size;      // sizeof(Z80::State) — layout guard
+    uint32_t bus_size;      // sizeof(Bus::State)
+    uint32_t reserved;
+    uint64_t key;
+    uint64_t total_ticks;
+};
+}  // namespace
+
+// ============================================================================
+// KEY
+// ============================================================================
+bool BootCache::init(Bus& bus, uint64_t options) {
+    armed_ = false;
+    if (!bus.fdc_present()) return false;
+
+    uint64_t h = fnv1a(bus.get_rom().data(), bus.get_rom().size());
+    for (int drive = 0; drive < FDC::DRIVES; drive++) {
+        uint64_t img;
+        if (!bus.fdc().image_hash(drive, img)) {
+            std::cout << "[BOOTCACHE] Drive " << drive
+                      << " is a host directory — boot cache off\n";
+            return false;
+        }
+        h = fnv1a(&img, sizeof(img), h);
+    }
+    h = fnv1a(&options, sizeof(options), h);
+
+    key_ = h;
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.state", static_cast<unsigned long long>(key_));
+    path_  = std::string(CACHE_DIR) + "/" + name;
+    armed_ = true;
+    return true;
+}
+
+// ============================================================================
+// RESTORE
+// ============================================================================
+bool BootCache::restore(Z80& cpu, Bus& bus, uint64_t& total_ticks) {
+    if (!armed_) return false;
+    std::ifstream f(path_, std::ios::binary);
+    if (!f) return false;
+
+    Header hdr{};
+    auto cpu_state = Z80::State{};
+    auto bus_state = std::make_unique<Bus::State>();
+    f.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    if (!f || std::memcmp(hdr.magic, MAGIC, sizeof(MAGIC)) != 0 || hdr.version != VERSION ||
+        hdr.cpu_size != sizeof(Z80::State) || hdr.bus_size != sizeof(Bus::State) ||
+        hdr.key != key_) {
+        std::cerr << "[BOOTCACHE] Ignoring stale " << path_ << "\n";
+        return false;
+    }
+    f.read(reinterpret_cast<char*>(&cpu_state), sizeof(cpu_state));
+    f.read(reinterpret_cast<char*>(bus_state.get()), sizeof(Bus::State));
+    if (!f) {
+        std::cerr << "[BOOTCACHE] Truncated " << path_ << "\n";
+        return false;
+    }
+
+    cpu.load_state(cpu_state);
+    bus.load_state(*bus_state);
+    total_ticks = hdr.total_ticks;
+    armed_      = false;
+    std::cout << "[BOOTCACHE] Resumed from " << path_ << "\n";
+    return true;
+}
+
+// ============================================================================
+// CAPTURE
+// ============================================================================
+void BootCache::on_frame(Z80& cpu, Bus& bus, uint64_t total_ticks,
+                         const uint8_t* keyboard_matrix, bool idle) {
+    if (!armed_) return;
+    if (++frames_ > GIVE_UP_FRAMES) { armed_ = false; return; }
+
+    if (keyboard_matrix) {
+        for (int row = 0; row < 8; row++) {
+            if (keyboard_matrix[row]) {
+                std::cout << "[BOOTCACHE] Key pressed during boot — not caching this one\n";
+                armed_ = false;
+                return;
+            }
+        }
+    }
+    if (!idle || cpu.has_prefix_pending()) { stable_ = 0; return; }
+
+    char screen[VRAM_SIZE + 1];
+    for (uint16_t i = 0; i < VRAM_SIZE; i++)
+        screen[i] = static_cast<char>(bus.get_vram_byte(i) & 0x7F);
+    screen[VRAM_SIZE] = '\0';
+
+    uint64_t h = fnv1a(screen, VRAM_SIZE);
+    if (h != vram_hash_) { vram_hash_ = h; stable_ = 0; return; }
+    if (++stable_ < STABLE_FRAMES) return;
+
+    for (char& c : screen) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    if (!std::strstr(screen, "READY")) return;
+
+    for (int drive = 0; drive < FDC::DRIVES; drive++) {
+        if (bus.fdc().is_dirty(drive)) {
+            std::cout << "[BOOTCACHE] Boot wrote to drive " << drive << " — not caching\n";
+            armed_ = false;
+            return;
+        }
+    }
+    save(cpu, bus, total_ticks);
+    armed_ = false;
+}
+
+bool BootCache::save(Z80& cpu, Bus& bus, uint64_t total_ticks) {
+    std::error_code ec;
+    std::filesystem::create_directories(CACHE_DIR, ec);
+
+    Header hdr{};
+    std::memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+    hdr.version     = VERSION;
+    hdr.cpu_size    = sizeof(Z80::State);
+    hdr.bus_size    = sizeof(Bus::State);
+    hdr.key         = key_;
+    hdr.total_ticks = total_ticks;
+
+    auto cpu_state = cpu.save_state();
+    auto bus_state = std::make_unique<Bus::State>();
+    bus.save_state(*bus_state);
+
+    // Write to a temp name and rename, so a crash never leaves a torn file
+    std::string tmp = path_ + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        f.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+        f.write(reinterpret_cast<const char*>(&cpu_state), sizeof(cpu_state));
+        f.write(reinterpret_cast<const char*>(bus_state.get()), sizeof(Bus::State));
+        if (!f) {
+            std::cerr << "[BOOTCACHE] Cannot write " << tmp << "\n";
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) {
+        std::cerr << "[BOOTCACHE] Cannot write " << path_ << ": " << ec.message() << "\n";
+        return false;
+    }
+    std::cout << "[BOOTCACHE] Saved ready state to " << path_ << "\n";
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+class Z80;
+class Bus;
+
+// Warm-start cache for disk boots.
+//
+// The first run with a given ROM + set of disk images boots normally; once
+// the DOS sits at a stable ready prompt the whole machine (Z80::State and
+// Bus::State, which includes the FDC) is written to bootcache/<key>.state.
+// Later runs with the same media load that file instead of booting.
+//
+// The key is an FNV-1a hash of the ROM, every mounted image's content and
+// the options that change how a boot unfolds (FDC timing, auto date).
+// Changed media → different key → normal boot.  Files are raw struct dumps
+// guarded by magic, version and struct sizes, so a build with a different
+// layout simply misses.
+//
+// "Stable ready" means: no injection, disk or cassette activity; VRAM
+// unchanged for STABLE_FRAMES; the screen shows "READY" (any case); no
+// dirty disk.  A key press before that point disarms capture — the state
+// would include whatever the user started doing.
+class BootCache {
+public:
+    static constexpr int STABLE_FRAMES = 60;         // 1 s of unchanged screen
+    static constexpr int GIVE_UP_FRAMES = 60 * 120;  // stop looking after 2 min
+
+    // Compute the key for the current media.  Returns false (cache off)
+    // when no disk is mounted or a drive is a host directory.
+    bool init(Bus& bus, uint64_t options);
+
+    // Resume from the cache file if there is one for this key.
+    bool restore(Z80& cpu, Bus& bus, uint64_t& total_ticks);
+
+    // Call once per displayed frame while armed.  `idle` is false while
+    // keystrokes are injected or the disk/cassette is active.
+    void on_frame(Z80& cpu, Bus& bus, uint64_t total_ticks,
+                  const uint8_t* keyboard_matrix, bool idle);
+
+    bool armed() const { return armed_; }
+
+private:
+    bool        armed_  = false;
+    uint64_t    key_    = 0;
+    std::string path_;
+    uint64_t    vram_hash_ = 0;
+    int         stable_    = 0;
+    int         frames_    = 0;
+
+    bool save(Z80& cpu, Bus& bus, uint64_t total_ticks);
+};
@@ -0,0 +1,84 @@
+#include "CoreStep.hpp"
+#include "cpu/z80.hpp"
+#include "cpu/Timing.hpp"
+#include "system/Bus.hpp"
+#include "fdc/FastDisk.hpp"
+#include "SoftwareLoader.hpp"
+#include "KeyInjector.hpp"
+#include "FloatHLE.hpp"
+#include "VideoHLE.hpp"
+
+CoreStep::Kind CoreStep::intercept(uint64_t& t_states, bool speculating) {
+    uint16_t pc = cpu.get_pc();
+    bus.set_cpu_pc(pc);
+
+    if (loader) {
+        loader->on_system_entry(pc, cpu, bus);
+        loader->on_cload_entry(pc, cpu, bus, injector);
+        loader->on_cload_tracking(pc, cpu, bus, injector);
+        loader->on_csave_entry(pc, bus);
+
+        // Intercept RST 28h when a CMD was loaded (no LDOS present) to
+        // handle @OPEN/@READ/@CLOSE/@LOAD overlay SVCs transparently.
+        if (loader->cmd_loaded() && pc == 0x0028) {
+            loader->on_svc_entry(cpu, bus);
+            return Kind::SVC;   // we faked the RST
+        }
+    }
+
+    if (injector.handle_intercept(pc, cpu, bus, t_states)) return Kind::KEY;
+
+    // CSAVE: bytes straight to the tape buffer, no FSK.
+    if (loader && loader->on_csave_byte(pc, cpu, bus, t_states)) return Kind::CSAVE;
+
+    // BASIC float arithmetic and screen output in native code.
+    if (!(speculating && fp.mode() == FloatHLE::Mode::VERIFY) &&
+        fp.handle_intercept(pc, cpu, bus, t_states))
+        return Kind::FP_HLE;
+    if (!(speculating && video.mode() == VideoHLE::Mode::VERIFY) &&
+        video.handle_intercept(pc, cpu, bus, t_states))
+        return Kind::VIDEO_HLE;
+
+    // Sector DRQ copy loop: move the whole sector in one host step.
+    if (fast_disk.handle_intercept(pc, cpu, bus, t_states)) return Kind::FAST_DISK;
+
+    return Kind::CPU;
+}
+
+int CoreStep::instruction(uint64_t& t_states) {
+    int ticks = cpu.step();
+    bus.add_ticks(ticks);
+    t_states += static_cast<uint64_t>(ticks);
+
+    deliver_interrupt(t_states);
+
+    if (bus.is_recording_idle() || bus.is_playback_done())
+        bus.stop_cassette();
+    return ticks;
+}
+
+void CoreStep::deliver_interrupt(uint64_t& t_states) {
+    if (!bus.interrupt_pending() || !cpu.get_iff1()) return;
+    // Real Z80 never accepts an interrupt between a prefix byte and its operand.
+    if (cpu.has_prefix_pending()) return;
+
+    bus.clear_interrupt();
+    cpu.set_iff2(cpu.get_iff1());  // save IFF1 into IFF2 before disabling
+    cpu.set_iff1(false);
+
+    if (cpu.get_halted()) {
+        cpu.set_halted(false);
+        cpu.set_pc(cpu.get_pc() + 1);  // resume after HALT
+    }
+
+    // Push PC and jump to IM1 vector (RST 38h)
+    uint16_t sp  = cpu.get_sp() - 2;
+    uint16_t ret = cpu.get_pc();
+    bus.write(sp,     ret & 0xFF);
+    bus.write(sp + 1, ret >> 8);
+    cpu.set_sp(sp);
+    cpu.set_pc(0x0038);
+
+    bus.add_ticks(T_IM1_ACK);
+    t_states += T_IM1_ACK;
+}
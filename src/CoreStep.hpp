@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+class Z80;
+class Bus;
+class SoftwareLoader;
+class KeyInjector;
+class FloatHLE;
+class VideoHLE;
+class FastDisk;
+
+// One pass of the emulator's loop: the ROM loader hooks, then the first host
+// intercept that claims pc ($KEY injection, CSAVE bytes, --fp-hle,
+// --video-hle, --fast-disk) standing in for a whole ROM routine, else one
+// Z80 instruction followed by IM 1 interrupt acknowledge.
+//
+// mal-80 (Emulator::step_once), libmal80 and divergence_bisect all step
+// through here, so a machine with the same options runs the same way in
+// each.  The callers add only what is theirs: the trace, sound, run-ahead
+// and rewind bookkeeping.
+struct CoreStep {
+    // What a step ran.
+    enum class Kind { CPU, SVC, KEY, CSAVE, FP_HLE, VIDEO_HLE, FAST_DISK };
+
+    Z80&            cpu;
+    Bus&            bus;
+    KeyInjector&    injector;
+    FloatHLE&       fp;
+    VideoHLE&       video;
+    FastDisk&       fast_disk;
+    SoftwareLoader* loader = nullptr;   // null: no SYSTEM/CLOAD/CSAVE/SVC hooks
+
+    // Loader hooks and host intercepts at the current pc.  CPU if none
+    // claimed the step (nothing has run yet); otherwise the step is done and
+    // its T-states are added to `t_states`.  `speculating` (run-ahead,
+    // rewind replay) keeps --fp-hle / --video-hle verify bookkeeping out of
+    // frames that are rolled back.
+    Kind intercept(uint64_t& t_states, bool speculating = false);
+
+    // One instruction, then the IM 1 acknowledge if an interrupt is due.
+    // Both are added to `t_states`; returns the instruction's alone.
+    int instruction(uint64_t& t_states);
+
+    // intercept(), else instruction().
+    Kind step(uint64_t& t_states, bool speculating = false) {
+        Kind k = intercept(t_states, speculating);
+        if (k == Kind::CPU) instruction(t_states);
+        return k;
+    }
+
+private:
+    void deliver_interrupt(uint64_t& t_states);
+};
@@ -41,22 +41,25 @@ void Debugger::dump_to(const Bus& bus, const std::string& filename) {
         return;
     }
     out << "# Mal-80 freeze trace — last " << count_ << " instructions\n";
-    out << "# TICKS       PC   SP   AF   BC   DE   HL   IX   IY  I IM IFF OP\n";
+    out << "# TICKS       PC   SP   AF   BC   DE   HL   IX   IY  I IM IFF BYTES        INSTRUCTION\n";
 
     size_t start = (count_ < BUF_SIZE) ? 0 : head_;
     for (size_t n = 0; n < count_; n++) {
         const TraceEntry& e = buf_[(start + n) % BUF_SIZE];
-        uint8_t op0 = bus.peek(e.pc);
-        uint8_t op1 = bus.peek(e.pc + 1);
-        char line[128];
+        int len;
+        const char* text = disasm_.at(bus, e.pc, len);
+        char op[Disasm::MAX_LEN * 3 + 1] = "";
+        for (int i = 0; i < len; i++)
+            snprintf(op + i * 3, 4, "%02X ", bus.peek(static_cast<uint16_t>(e.pc + i)));
+        char line[160];
         snprintf(line, sizeof(line),
-            "%12llu  %04X %04X  %02X%02X %04X %04X %04X  %04X %04X  %02X %d %d%d  %02X %02X%s%s\n",
+            "%12llu  %04X %04X  %02X%02X %04X %04X %04X  %04X %04X  %02X %d %d%d  %-12s %-18s%s%s\n",
             (unsigned long long)e.ticks,
             e.pc, e.sp,
             e.a, e.f, (e.b << 8) | e.c, (e.d << 8) | e.e, (e.h << 8) | e.l,
             e.ix, e.iy,
             e.i_reg, e.im, (int)e.iff1, (int)e.iff2,
-            op0, op1,
+            op, text,
             e.halted ? " HALT" : "",
             e.iff1   ? "" : " DI");
         out << line;
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <array>
 #include <string>
+#include "cpu/Disasm.hpp"
 
 class Z80;
 class Bus;
@@ -23,7 +24,8 @@ public:
     // Snapshot current CPU state into the circular buffer.
     void record(Z80& cpu, uint64_t ticks);
 
-    // Write the last N instructions to trace.log.
+    // Write the last N instructions to trace.log, disassembled from
+    // current memory.
     void dump(const Bus& bus);
     void dump_to(const Bus& bus, const std::string& filename);
 
@@ -33,4 +35,5 @@ private:
     std::array<TraceEntry, BUF_SIZE> buf_{};
     size_t   head_  = 0;
     size_t   count_ = 0;
+    Disasm   disasm_;   // loops in the trace decode once
 };
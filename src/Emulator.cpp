@@ -1,14 +1,18 @@
 #include "Emulator.hpp"
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 #include <fstream>
+#include <limits>
 #include <SDL.h>
 #include "tinyfiledialogs.h"
 
 static constexpr uint64_t T_STATES_PER_FRAME = 29498;        // ~60 Hz
-static constexpr uint64_t TURBO_T_STATES     = T_STATES_PER_FRAME * 100;
-static constexpr int      TURBO_RENDER_EVERY = 10;
-static constexpr int      NORMAL_FRAME_US    = 16667;         // ~60 Hz in µs
+// Unlimited speed runs this much per loop iteration between event polls.
+static constexpr uint64_t UNLIMITED_SLICE    = T_STATES_PER_FRAME * 10;
+static constexpr int      MAX_RUN_AHEAD      = 3;
+static constexpr int      MAX_REWIND_SECONDS = 600;
+static constexpr int      STATS_WINDOW       = 60;       // frames: one second
 
 Emulator::Emulator() : cpu_(bus_) {
     std::memset(keyboard_matrix_, 0, sizeof(keyboard_matrix_));
@@ -24,6 +28,7 @@ bool Emulator::init(int argc, char* argv[]) {
     std::string cli_load_name;
     std::string cli_cmd_arg;
     std::string cli_disk_path[4];
+    std::string cli_new_disk[4];
     int         cli_phosphor  = 2;  // default: green
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
@@ -32,7 +37,9 @@ bool Emulator::init(int argc, char* argv[]) {
                 "\n"
                 "Options:\n"
                 "  --load <name>       Auto-load a file from software/ on startup.\n"
-                "                      Case-insensitive prefix match; supports .cas and .bas.\n"
+                "                      Case-insensitive prefix match; supports .cas and .bas,\n"
+                "                      including entries of software/*.zip.  A path to a\n"
+                "                      .cas/.bas (also through a zip) is used as given.\n"
                 "                      e.g. --load scarfman\n"
                 "\n"
                 "  --cmd <arg>         Load a .cmd binary (machine-language disk program)\n"
@@ -46,14 +53,89 @@ bool Emulator::init(int argc, char* argv[]) {
                 "                      intercept (@OPEN/@READ/@CLOSE/@LOAD) are resolved\n"
                 "                      from the same zip or directory automatically.\n"
                 "\n"
-                "  --disk <path>       Mount a JV1 disk image on drive 0 (boot drive).\n"
-                "  --disk0 <path>      Mount a JV1 disk image on drive 0.\n"
-                "  --disk1 <path>      Mount a JV1 disk image on drive 1.\n"
-                "  --disk2 <path>      Mount a JV1 disk image on drive 2.\n"
-                "  --disk3 <path>      Mount a JV1 disk image on drive 3.\n"
+                "  --disk <path>       Mount a JV1/JV3/IMD disk image on drive 0 (boot drive).\n"
+                "  --disk0 <path>      Mount a JV1/JV3/IMD disk image on drive 0.\n"
+                "  --disk1 <path>      Mount a JV1/JV3/IMD disk image on drive 1.\n"
+                "  --disk2 <path>      Mount a JV1/JV3/IMD disk image on drive 2.\n"
+                "  --disk3 <path>      Mount a JV1/JV3/IMD disk image on drive 3.\n"
+                "                      A directory path mounts it as an LDOS data disk\n"
+                "                      (files read on demand, writes go to the host).\n"
+                "                      Zip-transparent: a .zip mounts its first disk image,\n"
+                "                      and games/pack/x.dsk reads x.dsk from games/pack.zip.\n"
                 "                      JV1 format: 35 tracks x 10 sectors x 256 bytes.\n"
+                "  --new-disk <n> <path>\n"
+                "                      Mount a blank unformatted disk on drive n (0-3) for\n"
+                "                      FORMAT; it is written to <path> on exit.\n"
+                "  --save-disks        Write modified disk images back to their files on exit.\n"
                 "\n"
-                "  --auto-ldos-date    Auto-inject today's date/time when LDOS asks 'Date ?'.\n"
+                "  --fdc-timing <mode> Disk controller timing: zero (default) completes every\n"
+                "                      command instantly; accurate models rotation, step\n"
+                "                      rates and per-byte DRQ for timing-sensitive software.\n"
+                "\n"
+                "  --fast-disk         Transfer whole sectors in one step when the DOS enters\n"
+                "                      its FDC DRQ copy loop (same result, far fewer steps).\n"
+                "\n"
+                "  --fp-hle <mode>     BASIC single-precision + - * / in native code: on runs\n"
+                "                      them natively (same results, far faster); verify lets\n"
+                "                      the ROM run and checks every result against native.\n"
+                "  --fp-cost <T>       T-states charged per native call (default 100).\n"
+                "  --video-hle <mode>  ROM screen output (CALL 0033h) in native code: on\n"
+                "                      prints and scrolls in one step once the ROM driver\n"
+                "                      has agreed on the first calls; verify checks the\n"
+                "                      ROM's VRAM and cursor against native throughout.\n"
+                "\n"
+                "  --no-rom-xlat       Interpret the ROM instead of running the code translated\n"
+                "                      from roms/level2.rom at build time.\n"
+                "\n"
+                "  --fsk-csave         Record CSAVE through real 500-baud FSK decoding instead\n"
+                "                      of taking each byte from the ROM write routine.\n"
+                "\n"
+                "  --auto-ldos-date    Answer LDOS's 'Date ?' prompt with 01/01/84 00:00:00.\n"
+                "\n"
+                "  --speed <factor>    Emulation speed as a multiple of a real Model I:\n"
+                "                      0.25 to 1000, or max for unlimited (default 1).\n"
+                "                      Ctrl+- / Ctrl+= step through 0.25x .. 16x, max.\n"
+                "\n"
+                "  --no-boot-cache     Always boot disks from scratch.  By default the first\n"
+                "                      boot with a given ROM + disk set saves the machine at\n"
+                "                      the DOS ready prompt to bootcache/, and later runs\n"
+                "                      with the same media resume from it.\n"
+                "\n"
+                "  --no-auto-turbo     Stay at 1x while the disk or cassette is busy (by default\n"
+                "                      the emulator runs unthrottled until the I/O finishes).\n"
+                "\n"
+                "  --sync <clock>      Frame pacing clock: host (default) paces 60 Hz from the\n"
+                "                      system timer; audio follows the sound card so the\n"
+                "                      audio queue never drifts; vsync follows the display\n"
+                "                      refresh (best on a 60 Hz monitor).\n"
+                "\n"
+                "  --run-ahead <n>     Show each frame n frames early (1-3): emulate ahead with\n"
+                "                      the current keys, display that, then roll back.  Cuts\n"
+                "                      input latency in games that react a frame or more late.\n"
+                "\n"
+                "  --rewind <seconds>  Keep the last <seconds> of emulation (0-600) for reverse\n"
+                "                      execution: F11 opens a console on the terminal to\n"
+                "                      step or run backwards and find the last write to an\n"
+                "                      address.  About 0.25 MB per second kept.\n"
+                "\n"
+                "  --coverage <file>   Record the Z80 code executed (instruction starts and\n"
+                "                      taken/not-taken branches) and OR it into <file> on\n"
+                "                      exit; parallel runs can share one file.  Disables the\n"
+                "                      boot cache.  Report with ./coverage_report.\n"
+                "\n"
+                "  --bus-stats <file>  Count reads, writes and opcode fetches per 256-byte\n"
+                "                      page and accesses per device (keyboard, VRAM, 0x37E0\n"
+                "                      latch, FDC registers, ports) and write them to <file>\n"
+                "                      as one JSON line per window.  The ROM is interpreted\n"
+                "                      and --fast-disk, --fp-hle on and --video-hle on are\n"
+                "                      ignored, so all guest code goes through the bus.\n"
+                "  --bus-stats-window <frames>\n"
+                "                      Frames per window (default 60, one second).\n"
+                "\n"
+                "  --hud               Start with the performance HUD on (F2 toggles it): host\n"
+                "                      ms per frame for emulation, render, texture upload,\n"
+                "                      present, audio and sleep; emulated MHz, speed, audio\n"
+                "                      queue depth and late / dropped frames.\n"
                 "\n"
                 "  --colour <name>     Set the phosphor colour on startup.\n"
                 "  --color  <name>     <name> is one of: white, amber, green (default: green).\n"
@@ -61,12 +143,15 @@ bool Emulator::init(int argc, char* argv[]) {
                 "  --help, -h          Print this help and exit.\n"
                 "\n"
                 "Hotkeys (in emulator window):\n"
+                "  F2           Performance HUD\n"
                 "  F5           @ key      F8           Quit\n"
                 "  F6           0 key      F9           Toggle CRT effects\n"
                 "  F7           Dump RAM   Shift+F9     Cycle phosphor colour\n"
                 "  F10          Warm boot  Shift+F10    Hard reset\n"
+                "  F11          Rewind console (with --rewind)\n"
                 "  Ctrl+V       Paste clipboard as keystrokes\n"
                 "  Ctrl+0..3    Mount disk image on drive 0-3\n"
+                "  Ctrl+- / =   Slower / faster (0.25x .. unlimited)\n"
                 "  Shift+F11    Hotkey help overlay\n";
             return false;  // exit cleanly without running the emulator
         } else if (std::strcmp(argv[i], "--load") == 0 && i + 1 < argc)
@@ -83,8 +168,107 @@ bool Emulator::init(int argc, char* argv[]) {
             cli_disk_path[2] = argv[++i];
         else if (std::strcmp(argv[i], "--disk3") == 0 && i + 1 < argc)
             cli_disk_path[3] = argv[++i];
+        else if (std::strcmp(argv[i], "--new-disk") == 0 && i + 2 < argc) {
+            int drive = std::atoi(argv[++i]);
+            const char* path = argv[++i];
+            if (drive >= 0 && drive < 4) {
+                cli_new_disk[drive] = path;
+            } else {
+                std::cerr << "[WARN] --new-disk drive must be 0-3\n";
+            }
+        }
+        else if (std::strcmp(argv[i], "--save-disks") == 0)
+            save_disks_ = true;
+        else if (std::strcmp(argv[i], "--fdc-timing") == 0 && i + 1 < argc) {
+            std::string m = argv[++i];
+            if      (m == "accurate") bus_.fdc().set_timing(FDC::Timing::ACCURATE);
+            else if (m == "zero")     bus_.fdc().set_timing(FDC::Timing::ZERO_LATENCY);
+            else std::cerr << "[WARN] Unknown FDC timing '" << m
+                           << "' — use zero or accurate\n";
+        }
+        else if (std::strcmp(argv[i], "--fast-disk") == 0)
+            fast_disk_.set_enabled(true);
+        else if (std::strcmp(argv[i], "--fp-hle") == 0 && i + 1 < argc) {
+            std::string m = argv[++i];
+            if      (m == "on")     float_hle_.set_mode(FloatHLE::Mode::ON);
+            else if (m == "verify") float_hle_.set_mode(FloatHLE::Mode::VERIFY);
+            else if (m == "off")    float_hle_.set_mode(FloatHLE::Mode::OFF);
+            else std::cerr << "[WARN] Unknown --fp-hle mode '" << m
+                           << "' — use on, verify or off\n";
+        }
+        else if (std::strcmp(argv[i], "--fp-cost") == 0 && i + 1 < argc) {
+            int t = std::atoi(argv[++i]);
+            if (t >= 0) float_hle_.set_cost(t);
+            else std::cerr << "[WARN] --fp-cost must be 0 or more\n";
+        }
+        else if (std::strcmp(argv[i], "--video-hle") == 0 && i + 1 < argc) {
+            std::string m = argv[++i];
+            if      (m == "on")     video_hle_.set_mode(VideoHLE::Mode::ON);
+            else if (m == "verify") video_hle_.set_mode(VideoHLE::Mode::VERIFY);
+            else if (m == "off")    video_hle_.set_mode(VideoHLE::Mode::OFF);
+            else std::cerr << "[WARN] Unknown --video-hle mode '" << m
+                           << "' — use on, verify or off\n";
+        }
+        else if (std::strcmp(argv[i], "--no-rom-xlat") == 0)
+            rom_xlat_ = false;
+        else if (std::strcmp(argv[i], "--fsk-csave") == 0)
+            loader_.set_fast_csave(false);
         else if (std::strcmp(argv[i], "--auto-ldos-date") == 0)
             auto_ldos_date_ = true;
+        else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            std::string v = argv[++i];
+            // Only the words mean unlimited: SPEED_UNLIMITED is 0, which a
+            // typo must not parse to.
+            char*  end = nullptr;
+            double f   = std::strtod(v.c_str(), &end);
+            if (v == "max" || v == "unlimited")
+                user_speed_ = cur_speed_ = SPEED_UNLIMITED;
+            else if (end != v.c_str() && *end == '\0' && f >= SPEED_MIN && f <= SPEED_MAX)
+                user_speed_ = cur_speed_ = f;
+            else
+                std::cerr << "[WARN] --speed must be 0.25-1000 or max\n";
+        }
+        else if (std::strcmp(argv[i], "--no-boot-cache") == 0)
+            boot_cache_enabled_ = false;
+        else if (std::strcmp(argv[i], "--no-auto-turbo") == 0)
+            auto_turbo_ = false;
+        else if (std::strcmp(argv[i], "--run-ahead") == 0 && i + 1 < argc) {
+            run_ahead_ = std::atoi(argv[++i]);
+            if (run_ahead_ < 0 || run_ahead_ > MAX_RUN_AHEAD) {
+                std::cerr << "[WARN] --run-ahead must be 0-" << MAX_RUN_AHEAD << "\n";
+                run_ahead_ = 0;
+            }
+        }
+        else if (std::strcmp(argv[i], "--rewind") == 0 && i + 1 < argc) {
+            int seconds = std::atoi(argv[++i]);
+            if (seconds >= 0 && seconds <= MAX_REWIND_SECONDS)
+                rewind_.set_seconds(seconds);
+            else
+                std::cerr << "[WARN] --rewind must be 0-" << MAX_REWIND_SECONDS << " seconds\n";
+        }
+        else if (std::strcmp(argv[i], "--coverage") == 0 && i + 1 < argc) {
+            coverage_path_ = argv[++i];
+            boot_cache_enabled_ = false;   // a warm start would skip the boot code
+        }
+        else if (std::strcmp(argv[i], "--bus-stats") == 0 && i + 1 < argc)
+            bus_stats_path_ = argv[++i];
+        else if (std::strcmp(argv[i], "--bus-stats-window") == 0 && i + 1 < argc) {
+            bus_stats_window_ = std::atoi(argv[++i]);
+            if (bus_stats_window_ < 1) {
+                std::cerr << "[WARN] --bus-stats-window must be at least 1 frame\n";
+                bus_stats_window_ = STATS_WINDOW;
+            }
+        }
+        else if (std::strcmp(argv[i], "--hud") == 0)
+            display_.hud().set_enabled(true);
+        else if (std::strcmp(argv[i], "--sync") == 0 && i + 1 < argc) {
+            std::string m = argv[++i];
+            if      (m == "host")  pacer_.set_mode(SyncMode::HOST);
+            else if (m == "audio") pacer_.set_mode(SyncMode::AUDIO);
+            else if (m == "vsync") pacer_.set_mode(SyncMode::VSYNC);
+            else std::cerr << "[WARN] Unknown sync mode '" << m
+                           << "' — use host, audio or vsync\n";
+        }
         else if ((std::strcmp(argv[i], "--colour") == 0 ||
                   std::strcmp(argv[i], "--color")  == 0) && i + 1 < argc) {
             std::string c = argv[++i];
@@ -112,13 +296,48 @@ bool Emulator::init(int argc, char* argv[]) {
 
     cpu_.reset();
     bus_.set_keyboard_matrix(keyboard_matrix_);
-    frame_start_ = std::chrono::steady_clock::now();
+    // Translated ROM code compiles its opcode and operand bytes in, and the
+    // native fast paths move data with peek() and direct FDC calls, so none
+    // of it would be counted: interpret the ROM and run the guest's own disk,
+    // FP and video code while counting.
+    if (!bus_stats_path_.empty()) {
+        if (bus_stats_.open(bus_stats_path_, bus_stats_window_)) {
+            bus_.set_stats(&bus_stats_);
+            rom_xlat_ = false;
+            fast_disk_.set_enabled(false);
+            if (float_hle_.mode() == FloatHLE::Mode::ON) float_hle_.set_mode(FloatHLE::Mode::OFF);
+            if (video_hle_.mode() == VideoHLE::Mode::ON) video_hle_.set_mode(VideoHLE::Mode::OFF);
+            std::cerr << "[STATS] Counting bus accesses into " << bus_stats_path_
+                      << ", " << bus_stats_window_ << " frames per window"
+                      << "; ROM interpreted, native disk, FP and video paths off\n";
+        } else {
+            std::cerr << "[STATS] Cannot create " << bus_stats_path_ << "\n";
+        }
+    }
+    float_hle_.attach(bus_);
+    video_hle_.attach(bus_);
+    if (rom_xlat_) RomXlat::attach(cpu_, bus_);
+    if (!coverage_path_.empty()) cpu_.set_coverage(&coverage_);
+    if (pacer_.mode() == SyncMode::VSYNC)
+        display_.set_vsync(true);
 
     for (int drive = 0; drive < 4; drive++) {
         if (!cli_disk_path[drive].empty()) {
             if (!bus_.load_disk(drive, cli_disk_path[drive]))
                 std::cerr << "Warning: failed to load disk" << drive << ": " << cli_disk_path[drive] << "\n";
         }
+        if (!cli_new_disk[drive].empty())
+            new_disk_[drive] = bus_.fdc().new_disk(drive, cli_new_disk[drive]);
+    }
+
+    // Warm start: a plain disk boot resumes from the cached ready state.
+    // With --auto-ldos-date that state is past the Date ? prompt; the date
+    // injected is a constant, so nothing in it goes stale.
+    if (boot_cache_enabled_ && cli_load_name.empty() && cli_cmd_arg.empty()) {
+        uint64_t options = (bus_.fdc().timing() == FDC::Timing::ACCURATE ? 1u : 0u) |
+                           (auto_ldos_date_ ? 2u : 0u);
+        if (boot_cache_.init(bus_, options) && boot_cache_.restore(cpu_, bus_, total_ticks_))
+            ldos_date_injected_ = true;
     }
 
     if (!cli_load_name.empty())
@@ -132,13 +351,15 @@ bool Emulator::init(int argc, char* argv[]) {
 }
 
 void Emulator::run() {
+    PerfHud& hud = display_.hud();
     while (display_.is_running()) {
         display_.handle_events(keyboard_matrix_);
 
         // ── Process emulator actions triggered by hotkeys ─────────────────
         {
             int drive_out = -1;
-            switch (display_.pop_action(drive_out)) {
+            DisplayAction action = display_.pop_action(drive_out);
+            switch (action) {
 
             case DisplayAction::SOFT_RESET:
                 // Warm boot: jump straight to the BASIC READY prompt,
@@ -151,9 +372,9 @@ void Emulator::run() {
                 bus_.stop_cassette();
                 display_.release_all_keys(keyboard_matrix_);
                 injector_.clear();
+                rewind_.clear();
                 cur_speed_          = user_speed_;
-                turbo_render_count_ = 0;
-                frame_start_        = std::chrono::steady_clock::now();
+                pacer_.reset();
                 sound_.clear();
                 break;
 
@@ -165,25 +386,26 @@ void Emulator::run() {
                 total_ticks_        = 0;
                 prev_pc_            = 0;
                 ldos_date_injected_ = false;
+                rewind_.clear();
                 cur_speed_          = user_speed_;
-                turbo_render_count_ = 0;
-                frame_start_        = std::chrono::steady_clock::now();
+                pacer_.reset();
                 sound_.clear();
                 break;
 
             case DisplayAction::MOUNT_DISK:
                 if (drive_out >= 0 && drive_out < 4) {
-                    static const char* filters[] = {"*.dsk","*.dmk","*.imd","*.jv1"};
+                    static const char* filters[] = {"*.dsk","*.dmk","*.imd","*.jv1","*.jv3","*.zip"};
                     char dlg_title[32];
                     snprintf(dlg_title, sizeof(dlg_title), "Mount disk — drive %d", drive_out);
                     const char* path = tinyfd_openFileDialog(
-                        dlg_title, "disks/", 4, filters, "Disk images", 0);
+                        dlg_title, "disks/", 6, filters, "Disk images", 0);
                     if (path && *path) {
                         if (!bus_.load_disk(drive_out, path))
                             std::cerr << "[DISK] Failed to mount: " << path << "\n";
+                        rewind_.clear();
                     }
-                    // Reset frame timer: dialog may have taken several seconds
-                    frame_start_ = std::chrono::steady_clock::now();
+                    // Restart pacing: dialog may have taken several seconds
+                    pacer_.reset();
                 }
                 break;
 
@@ -214,40 +436,75 @@ void Emulator::run() {
                 break;
             }
 
+            case DisplayAction::REWIND:
+                if (rewind_.enabled()) {
+                    rewind_.console();
+                    // The console blocked the loop: restart pacing and audio
+                    pacer_.reset();
+                    sound_.clear();
+                } else {
+                    std::cerr << "[REWIND] Off — start with --rewind <seconds>\n";
+                }
+                break;
+
+            case DisplayAction::SPEED_DOWN:
+            case DisplayAction::SPEED_UP:
+                step_user_speed(action == DisplayAction::SPEED_UP ? +1 : -1);
+                break;
+
             case DisplayAction::NONE:
             default:
                 break;
             }
         }
 
-        // Auto-select speed: turbo while keyboard injection is active
-        SpeedMode desired = injector_.is_active() ? SpeedMode::TURBO : user_speed_;
+        // Auto-select speed: turbo while keyboard injection is active, and
+        // (unless --no-auto-turbo) while the disk or cassette is working.
+        bool io_active = auto_turbo_ &&
+                         (bus_.fdc().is_active() ||
+                          bus_.get_cassette_state() != CassetteState::IDLE);
+        double desired = (injector_.is_active() || io_active)
+                         ? SPEED_UNLIMITED : user_speed_;
         if (desired != cur_speed_) {
             // When returning to normal speed, discard any silence that
             // accumulated during turbo so game audio starts immediately.
-            if (desired == SpeedMode::NORMAL)
+            if (desired == SPEED_NORMAL)
                 sound_.clear();
-            cur_speed_          = desired;
-            turbo_render_count_ = 0;
-            frame_start_        = std::chrono::steady_clock::now();
+            cur_speed_ = desired;
+            pacer_.reset();
+            if (pacer_.mode() == SyncMode::VSYNC)
+                display_.set_vsync(desired != SPEED_UNLIMITED);
         }
 
-        uint64_t t_budget = (cur_speed_ == SpeedMode::TURBO)
-                            ? TURBO_T_STATES : T_STATES_PER_FRAME;
-        step_frame(t_budget);
+        // Paced speeds run speed × one frame of T-states per 60 Hz tick;
+        // unlimited runs slices back to back.
+        bool     unlimited = (cur_speed_ == SPEED_UNLIMITED);
+        uint64_t t_budget  = unlimited ? UNLIMITED_SLICE
+                             : static_cast<uint64_t>(T_STATES_PER_FRAME * cur_speed_ + 0.5);
+        {
+            PerfHud::Scope emulate(hud, PerfHud::EMULATE);
+            step_frame(t_budget);
+        }
 
-        // Only push audio to SDL in normal mode.  In turbo mode the Z80 runs
-        // at 100× speed, making all tones inaudible — don't fill the queue
-        // with silence that would delay real game audio.
-        if (cur_speed_ == SpeedMode::NORMAL)
+        // Only push audio to SDL at 1×.  At any other speed tones come out
+        // at the wrong pitch (and are muted in step_frame) — don't fill the
+        // queue with silence that would delay real game audio.
+        if (cur_speed_ == SPEED_NORMAL) {
+            PerfHud::Scope audio(hud, PerfHud::AUDIO);
             sound_.flush();
+        }
 
         update_title();
 
-        bool should_render = (cur_speed_ == SpeedMode::NORMAL) ||
-                             (++turbo_render_count_ % TURBO_RENDER_EVERY == 0);
-        if (should_render)
-            display_.render_frame(bus_);
+        // Present at most once per 60 Hz period of wall-clock time.  Paced
+        // speeds get here exactly that often; unlimited would otherwise
+        // present thousands of frames a second that nobody sees.
+        auto now = std::chrono::steady_clock::now();
+        if (!unlimited || now - last_present_ >= FramePacer::PERIOD) {
+            last_present_ = now;
+            if (!(cur_speed_ == SPEED_NORMAL && render_ahead()))
+                display_.render_frame(bus_);
+        }
 
         // Per-frame VRAM scan: detect LDOS "Date ?" prompt and auto-inject date/time.
         if (auto_ldos_date_ && !ldos_date_injected_) {
@@ -269,88 +526,146 @@ void Emulator::run() {
             date_scan_done:;
         }
 
-        if (cur_speed_ == SpeedMode::NORMAL)
-            pace_frame();
-        frame_start_ = std::chrono::steady_clock::now();
+        boot_cache_.on_frame(cpu_, bus_, total_ticks_, keyboard_matrix_,
+                             !injector_.is_active() && !bus_.fdc().is_active() &&
+                             bus_.get_cassette_state() == CassetteState::IDLE);
+
+        if (!unlimited) {
+            PerfHud::Scope sleep(hud, PerfHud::SLEEP);
+            pacer_.wait(cur_speed_ == SPEED_NORMAL ? sound_.queued_frames() : -1.0);
+        }
+
+        hud.end_loop(total_ticks_, cur_speed_ == SPEED_NORMAL ? sound_.queued_frames() : -1.0,
+                     pacer_.late_frames(), pacer_.dropped_frames());
     }
 
+    // Persist formatted/written disks: always for --new-disk, otherwise only
+    // with --save-disks (images are never modified on disk by default).
+    for (int drive = 0; drive < 4; drive++) {
+        if (bus_.fdc().is_dirty(drive) && (save_disks_ || new_disk_[drive]))
+            bus_.fdc().save_disk(drive);
+    }
+
+    if (!coverage_path_.empty()) {
+        if (coverage_.merge_into(coverage_path_))
+            std::cerr << "[COV] Merged into " << coverage_path_ << "\n";
+        else
+            std::cerr << "[COV] Failed to write " << coverage_path_ << "\n";
+    }
+    bus_stats_.close();
+
     debugger_.dump(bus_);
+    pacer_.print_stats();
+    float_hle_.print_stats();
+    video_hle_.print_stats();
     sound_.cleanup();
     display_.cleanup();
     std::cout << "Mal-80 shutdown complete.\n";
 }
 
 void Emulator::step_frame(uint64_t t_budget) {
+    bool record = rewind_.enabled() && !speculating_;
+    if (record) rewind_.begin_frame(t_budget);
+
     uint64_t frame_ts = 0;
     while (frame_ts < t_budget) {
-        uint16_t pc = cpu_.get_pc();
-
-        prev_pc_ = pc;
-        bus_.set_cpu_pc(pc);
-
-        loader_.on_system_entry(pc, cpu_, bus_);
-        loader_.on_cload_entry(pc, cpu_, bus_, injector_);
-        loader_.on_cload_tracking(pc, cpu_, bus_, injector_);
-        loader_.on_csave_entry(pc, bus_);
-
-        // Phase 2: intercept RST 28h when a CMD was loaded (no LDOS present)
-        // to handle @OPEN/@READ/@CLOSE/@LOAD overlay SVCs transparently.
-        if (loader_.cmd_loaded() && pc == 0x0028) {
-            loader_.on_svc_entry(cpu_, bus_);
-            continue;  // skip cpu_.step() — we faked the RST
+        if (record) {
+            uint16_t pc = cpu_.get_pc();
+            rewind_.on_step(pc, loader_.is_intercept(pc));
         }
+        if (!step_once(frame_ts)) return;
+    }
+    if (record) rewind_.end_frame(frame_ts);
+    if (bus_.stats() && !speculating_) bus_stats_.end_frame(frame_ts);
+}
 
-        if (injector_.handle_intercept(pc, cpu_, bus_, frame_ts))
-            continue;
+// One pass of the loop: an instruction or a host intercept, then interrupt
+// delivery.  Returns false when run-ahead has to stop before pc.
+bool Emulator::step_once(uint64_t& frame_ts) {
+    uint16_t pc = cpu_.get_pc();
+    prev_pc_ = pc;
+
+    // Running ahead: stop before anything with host side effects — a loader
+    // intercept, or the data of a disk write, which the snapshot cannot take
+    // back from the image.  (Rewind replays restore the images themselves.)
+    if (speculating_ && (loader_.is_intercept(pc) ||
+                         (running_ahead_ && bus_.fdc().write_pending()))) {
+        spec_aborted_ = true;
+        return false;
+    }
 
-        debugger_.record(cpu_, total_ticks_);
+    // Every step charges its T-states to bus_ and frame_ts; mirror them
+    // into total_ticks_ so all three clocks agree.
+    uint64_t ts_before = frame_ts;
+    if (core_.intercept(frame_ts, speculating_) != CoreStep::Kind::CPU) {
+        total_ticks_ += frame_ts - ts_before;
+        return true;
+    }
 
-        int ticks = cpu_.step();
+    if (!speculating_)
+        debugger_.record(cpu_, total_ticks_);
 
-        bus_.add_ticks(ticks);
-        frame_ts     += ticks;
-        total_ticks_ += ticks;
+    int ticks = core_.instruction(frame_ts);
+    total_ticks_ += frame_ts - ts_before;
 
-        // Sample the sound bit after the instruction (port 0xFF may have changed).
-        // Mute during cassette I/O (FSK signal would be noise) and turbo mode
-        // (Z80 running 100× fast makes all tones inaudibly high).
-        bool sound_active = (cur_speed_ == SpeedMode::NORMAL) &&
-                            (bus_.get_cassette_state() == CassetteState::IDLE);
+    // Sample the sound bit after the instruction (port 0xFF may have changed).
+    // Mute during cassette I/O (FSK signal would be noise) and turbo mode
+    // (Z80 running 100× fast makes all tones inaudibly high).
+    bool sound_active = (cur_speed_ == SPEED_NORMAL) &&
+                        (bus_.get_cassette_state() == CassetteState::IDLE);
+    if (!speculating_)
         sound_.update(bus_.get_sound_bit(), ticks, sound_active);
-
-        deliver_interrupt(frame_ts);
-
-        if (bus_.is_recording_idle() || bus_.is_playback_done())
-            bus_.stop_cassette();
-    }
+    return true;
 }
 
-void Emulator::deliver_interrupt(uint64_t& frame_ts) {
-    if (!bus_.interrupt_pending() || !cpu_.get_iff1()) return;
-    // Real Z80 never accepts an interrupt between a prefix byte and its operand.
-    if (cpu_.has_prefix_pending()) return;
-
-    bus_.clear_interrupt();
-    cpu_.set_iff2(cpu_.get_iff1());  // save IFF1 into IFF2 before disabling
-    cpu_.set_iff1(false);
+// Run-ahead: snapshot the machine, emulate run_ahead_ more frames with the
+// current input, show the last of them, then roll back.  Games that react to
+// a key a frame or two after reading it show the reaction immediately.
+// Returns false (nothing rendered) when disabled or when speculation hit a
+// host-side intercept; the caller then renders the real frame.
+bool Emulator::render_ahead() {
+    if (run_ahead_ <= 0 || injector_.is_active() ||
+        bus_.get_cassette_state() != CassetteState::IDLE || bus_.fdc().is_active())
+        return false;
 
-    if (cpu_.get_halted()) {
-        cpu_.set_halted(false);
-        cpu_.set_pc(cpu_.get_pc() + 1);  // resume after HALT
+    if (!ra_bus_) ra_bus_ = std::make_unique<Bus::State>();
+    Z80::State cpu_state = cpu_.save_state();
+    bus_.save_state(*ra_bus_);
+    uint64_t ticks_before = total_ticks_;
+    uint16_t prev_pc      = prev_pc_;
+    FloatHLE fp           = float_hle_;   // ON checks ROM calls across steps
+    VideoHLE video        = video_hle_;
+
+    // The speculative frames may run on input the real ones never see: keep
+    // them out of the coverage and the bus counts.
+    Coverage* cov   = cpu_.coverage();
+    BusStats* stats = bus_.stats();
+    cpu_.set_coverage(nullptr);
+    bus_.set_stats(nullptr);
+    speculating_   = true;
+    running_ahead_ = true;
+    spec_aborted_  = false;
+    {
+        PerfHud::Scope emulate(display_.hud(), PerfHud::EMULATE);
+        for (int i = 0; i < run_ahead_ && !spec_aborted_; i++)
+            step_frame(T_STATES_PER_FRAME);
     }
-
-    // Push PC and jump to IM1 vector (RST 38h)
-    uint16_t sp  = cpu_.get_sp() - 2;
-    uint16_t ret = cpu_.get_pc();
-    bus_.write(sp,     ret & 0xFF);
-    bus_.write(sp + 1, ret >> 8);
-    cpu_.set_sp(sp);
-    cpu_.set_pc(0x0038);
-
-    constexpr int IM1_LATENCY = 13;  // 2 sample + 11 push+jump
-    bus_.add_ticks(IM1_LATENCY);
-    frame_ts     += IM1_LATENCY;
-    total_ticks_ += IM1_LATENCY;
+    speculating_   = false;
+    running_ahead_ = false;
+    cpu_.set_coverage(cov);
+    bus_.set_stats(stats);
+
+    bool shown = !spec_aborted_;
+    if (shown)
+        display_.render_frame(bus_);
+
+    cpu_.load_state(cpu_state);
+    bus_.load_state(*ra_bus_);
+    total_ticks_ = ticks_before;
+    prev_pc_     = prev_pc;
+    float_hle_   = fp;
+    video_hle_   = video;
+    return shown;
 }
 
 void Emulator::update_title() {
@@ -370,7 +685,8 @@ void Emulator::update_title() {
     }
 
     std::string status    = bus_.get_cassette_status();
-    std::string speed_tag = (cur_speed_ == SpeedMode::TURBO) ? " [TURBO]" : "";
+    std::string speed_tag = (cur_speed_ == SPEED_NORMAL) ? ""
+                          : " [" + speed_label(cur_speed_) + "]";
     display_.set_title(status.empty()
         ? base + " - TRS-80 Emulator" + speed_tag
         : base + " - " + status + speed_tag);
@@ -380,10 +696,30 @@ void Emulator::update_title() {
     prev_disk0_name_ = disk0;
 }
 
-void Emulator::pace_frame() {
-    auto now     = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-                       now - frame_start_).count();
-    if (elapsed < NORMAL_FRAME_US)
-        SDL_Delay(static_cast<uint32_t>((NORMAL_FRAME_US - elapsed) / 1000));
+// ============================================================================
+// SPEED
+// ============================================================================
+std::string Emulator::speed_label(double speed) {
+    if (speed == SPEED_UNLIMITED) return "TURBO";
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%gx", speed);
+    return buf;
+}
+
+// Move the user speed to the next slower/faster entry of SPEED_STEPS (from
+// wherever --speed put it, which need not be a step).
+void Emulator::step_user_speed(int dir) {
+    static constexpr double SPEED_STEPS[] = {0.25, 0.5, 1, 2, 4, 8, 16, SPEED_UNLIMITED};
+    auto rank = [](double s) {
+        return s == SPEED_UNLIMITED ? std::numeric_limits<double>::infinity() : s;
+    };
+    double cur = rank(user_speed_);
+    if (dir > 0) {
+        for (double st : SPEED_STEPS)
+            if (rank(st) > cur) { user_speed_ = st; break; }
+    } else {
+        for (double st : SPEED_STEPS)   // ascending: keeps the last one below
+            if (rank(st) < cur) user_speed_ = st;
+    }
+    std::cout << "[SPEED] " << speed_label(user_speed_) << "\n";
 }
@@ -1,15 +1,31 @@
 #pragma once
 #include "system/Bus.hpp"
 #include "cpu/z80.hpp"
+#include "cpu/RomXlat.hpp"
+#include "cpu/Coverage.hpp"
+#include "system/BusStats.hpp"
 #include "video/Display.hpp"
 #include "SoftwareLoader.hpp"
 #include "KeyInjector.hpp"
 #include "Debugger.hpp"
 #include "Sound.hpp"
+#include "fdc/FastDisk.hpp"
+#include "FloatHLE.hpp"
+#include "VideoHLE.hpp"
+#include "FramePacer.hpp"
+#include "BootCache.hpp"
+#include "TimeTravel.hpp"
+#include "CoreStep.hpp"
 #include <chrono>
 #include <cstring>
+#include <memory>
 
-enum class SpeedMode { NORMAL, TURBO };
+// Emulation speed as a multiple of a real Model I.  SPEED_UNLIMITED runs
+// flat out (auto-turbo during I/O, or --speed max).
+constexpr double SPEED_NORMAL    = 1.0;
+constexpr double SPEED_UNLIMITED = 0.0;
+constexpr double SPEED_MIN       = 0.25;
+constexpr double SPEED_MAX       = 1000.0;
 
 // Top-level emulator.  Owns the Bus, CPU, Display and all subsystems.
 // Call init() once, then run() to enter the main loop.
@@ -30,24 +46,58 @@ private:
     KeyInjector    injector_;
     Debugger       debugger_;
     Sound          sound_;
+    FastDisk       fast_disk_;
+    FloatHLE       float_hle_;
+    VideoHLE       video_hle_;
+    FramePacer     pacer_;
+    BootCache      boot_cache_;
+    // Loader hooks, host intercepts, instruction + IM 1 (as libmal80 and
+    // divergence_bisect run them)
+    CoreStep       core_{cpu_, bus_, injector_, float_hle_, video_hle_, fast_disk_, &loader_};
 
     uint8_t keyboard_matrix_[8]{};
 
-    SpeedMode user_speed_         = SpeedMode::NORMAL;
-    SpeedMode cur_speed_          = SpeedMode::NORMAL;
-    int       turbo_render_count_ = 0;
-    std::chrono::steady_clock::time_point frame_start_;
+    double    user_speed_         = SPEED_NORMAL;     // --speed / Ctrl+- Ctrl+=
+    double    cur_speed_          = SPEED_NORMAL;     // user_speed_ or auto-turbo
+    std::chrono::steady_clock::time_point last_present_{};
     uint64_t  total_ticks_        = 0;
 
     CassetteState prev_cas_state_  = CassetteState::IDLE;
-    SpeedMode     prev_speed_      = SpeedMode::NORMAL;
+    double        prev_speed_      = SPEED_NORMAL;
     std::string   prev_disk0_name_;
     uint16_t      prev_pc_         = 0;
     bool          ldos_date_injected_ = false;
     bool          auto_ldos_date_     = false;
+    bool          auto_turbo_         = true;    // turbo during disk/tape I/O
+    bool          boot_cache_enabled_ = true;    // --no-boot-cache clears
+    bool          save_disks_         = false;   // --save-disks
+    bool          rom_xlat_           = true;    // --no-rom-xlat clears
+    bool          new_disk_[4]        = {};      // drive created by --new-disk
+
+    // Run-ahead (--run-ahead n): frames emulated past the real one for display
+    int                         run_ahead_     = 0;
+    bool                        speculating_   = false;  // run-ahead or rewind replay
+    bool                        running_ahead_ = false;  // run-ahead only
+    bool                        spec_aborted_  = false;  // hit an intercept or disk write
+    std::unique_ptr<Bus::State> ra_bus_;                 // snapshot, ~75KB
+
+    // Reverse execution (--rewind <seconds>, F11 console)
+    TimeTravel rewind_{*this};
+    friend class TimeTravel;
+
+    // Code coverage (--coverage <file>): merged into the file on exit
+    Coverage    coverage_;
+    std::string coverage_path_;
+
+    // Bus access counters (--bus-stats <file>), one JSON line per window
+    BusStats    bus_stats_;
+    std::string bus_stats_path_;
+    int         bus_stats_window_ = 60;
 
     void step_frame(uint64_t t_budget);
-    void deliver_interrupt(uint64_t& frame_ts);
+    bool step_once(uint64_t& frame_ts);
+    bool render_ahead();
+    void step_user_speed(int dir);
+    static std::string speed_label(double speed);
     void update_title();
-    void pace_frame();
 };
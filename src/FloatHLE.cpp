@@ -0,0 +1,229 @@
+#include "FloatHLE.hpp"
+#include "cpu/z80.hpp"
+#include "system/Bus.hpp"
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+static constexpr uint16_t WRA1      = 0x4121;   // LSB, mid, sign+MSB, exponent
+static constexpr int      MAX_SHIFT = 25;       // FADD: smaller operand vanishes
+
+// Operand bytes are kept in WRA1 order: [0] LSB, [1] mid, [2] sign+MSB, [3] exp.
+static uint32_t mantissa(const uint8_t v[4]) {
+    return static_cast<uint32_t>((v[2] | 0x80) << 16 | v[1] << 8 | v[0]);
+}
+static bool negative(const uint8_t v[4]) { return v[2] & 0x80; }
+
+// ROUND + MOVFR: `s` is the normalised 24-bit mantissa with the guard byte
+// below it; a guard of 0x80 or more rounds up.
+static void round_pack(uint32_t s, int exp, bool neg, uint8_t out[4]) {
+    uint32_t m = s >> 8;
+    if (s & 0x80) {
+        if (++m == 0x1000000) { m = 0x800000; exp++; }
+    }
+    out[0] = static_cast<uint8_t>(m);
+    out[1] = static_cast<uint8_t>(m >> 8);
+    out[2] = static_cast<uint8_t>(((m >> 16) & 0x7F) | (neg ? 0x80 : 0));
+    out[3] = static_cast<uint8_t>(exp);
+}
+
+// ============================================================================
+// ARITHMETIC
+// ============================================================================
+// Computes the routine's result into wra1 (in place) and the BCDE it leaves
+// behind.  Returns false to leave the call to the ROM: result zero,
+// underflow or overflow possible, or divide by zero.
+bool FloatHLE::compute(Op op, const uint8_t arg[4], uint8_t wra1[4], uint8_t bcde[4]) {
+    uint8_t ae = arg[3], fe = wra1[3];
+
+    if (op == FADD) {
+        std::memcpy(bcde, arg, 4);
+        if (ae == 0) return true;                           // x + 0
+        if (fe == 0) { std::memcpy(wra1, arg, 4); return true; }
+
+        uint8_t x[4], y[4];                                 // x: larger exponent
+        std::memcpy(x, wra1, 4);
+        std::memcpy(y, arg, 4);
+        if (fe < ae) std::swap(x, y);
+        int diff = x[3] - y[3];
+        if (diff >= MAX_SHIFT) {
+            std::memcpy(wra1, x, 4);
+            std::memcpy(bcde, y, 4);
+            return true;
+        }
+        if (x[3] > 253) return false;
+
+        // Align: the smaller mantissa shifts right into the guard byte, bits
+        // beyond it are lost (no sticky bit).
+        uint64_t xm  = static_cast<uint64_t>(mantissa(x)) << 8;
+        uint64_t ym  = (static_cast<uint64_t>(mantissa(y)) << 8) >> diff;
+        int      exp = x[3];
+        bool     neg = negative(x);
+        uint64_t s;
+        if (negative(x) == negative(y)) {
+            s = xm + ym;
+            if (s >> 32) { s >>= 1; exp++; }
+        } else {
+            if (xm >= ym) {
+                s = xm - ym;
+            } else {
+                s   = ym - xm;
+                neg = !neg;
+            }
+            if (s == 0) return false;
+            while (!(s & 0x80000000u)) { s <<= 1; exp--; }
+            if (exp <= 0) return false;
+        }
+        round_pack(static_cast<uint32_t>(s), exp, neg, wra1);
+        std::memcpy(bcde, wra1, 4);
+        return true;
+    }
+
+    if (op == FMULT) {
+        if (fe == 0) { std::memcpy(bcde, arg, 4); return true; }   // 0 * x: untouched
+        if (ae == 0) return false;
+        int exp = fe + ae - 128;
+        if (exp < 3 || exp > 253) return false;
+
+        // Shift-and-add over 24 multiplier bits keeps the top 32 bits of the
+        // 48-bit product, truncated.
+        uint64_t s = (static_cast<uint64_t>(mantissa(arg)) * mantissa(wra1)) >> 16;
+        if (!(s & 0x80000000u)) { s <<= 1; exp--; }
+        round_pack(static_cast<uint32_t>(s), exp, negative(arg) != negative(wra1), wra1);
+        std::memcpy(bcde, wra1, 4);
+        return true;
+    }
+
+    // FDIV: restoring division, one quotient bit per step until 24 bits are
+    // in; the 25th bit alone decides rounding.
+    if (fe == 0 || ae == 0) return false;
+    int exp = ae - fe + 129;
+    if (exp < 3 || exp > 253) return false;
+
+    uint64_t r = mantissa(arg), v = mantissa(wra1);
+    uint32_t q = 0;
+    bool     guard;
+    for (;;) {
+        bool bit = r >= v;
+        if (bit) r -= v;
+        if (q & 0x800000) { guard = bit; break; }
+        q = q << 1 | bit;
+        r <<= 1;
+        if (q == 0) exp--;
+    }
+    round_pack(q << 8 | (guard ? 0x80 : 0), exp, negative(arg) != negative(wra1), wra1);
+    std::memcpy(bcde, wra1, 4);
+    return true;
+}
+
+// ============================================================================
+// ROM SIGNATURES
+// ============================================================================
+// FADD opens with "ld a,b / or a / ret z"; FMULT and FDIV both start by
+// calling the same SIGN routine, then "ret z" / "jp z,?/0 error".
+void FloatHLE::attach(const Bus& bus) {
+    auto b = [&](uint16_t a) { return bus.peek(a); };
+    uint16_t mul_sign = static_cast<uint16_t>(b(0x0848) | b(0x0849) << 8);
+    uint16_t div_sign = static_cast<uint16_t>(b(0x08A3) | b(0x08A4) << 8);
+
+    routines_[FADD].active  = b(0x0716) == 0x78 && b(0x0717) == 0xB7 && b(0x0718) == 0xC8;
+    routines_[FMULT].active = b(0x0847) == 0xCD && b(0x084A) == 0xC8;
+    routines_[FDIV].active  = b(0x08A2) == 0xCD && b(0x08A5) == 0xCA && div_sign == mul_sign;
+
+    if (mode_ == Mode::OFF) return;
+    for (const Routine& r : routines_) {
+        if (!r.active)
+            std::fprintf(stderr, "[FPHLE] %s at 0x%04X not recognised — left to the ROM\n",
+                         r.check.name(), r.addr);
+    }
+}
+
+// ============================================================================
+// INTERCEPT
+// ============================================================================
+bool FloatHLE::handle_intercept(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts) {
+    if (mode_ == Mode::OFF) return false;
+    for (Routine& r : routines_) {
+        if (!r.check.pending()) continue;
+        r.check.check_return(pc, cpu.get_sp(), bus.get_global_t_states(), mode_,
+                             [&](const Call& c, bool report) {
+                                 return same(c, report, cpu, bus, r.check.name());
+                             });
+    }
+
+    int op = 0;
+    while (op < OPS && routines_[op].addr != pc) op++;
+    if (op == OPS || !routines_[op].active) return false;
+    RomCheck<Call>& check = routines_[op].check;
+    if (mode_ == Mode::ON && check.failed()) return false;
+
+    uint8_t arg[4], wra1[4], bcde[4];
+    uint16_t bc = cpu.get_bc(), de = cpu.get_de();
+    arg[0] = static_cast<uint8_t>(de);
+    arg[1] = static_cast<uint8_t>(de >> 8);
+    arg[2] = static_cast<uint8_t>(bc);
+    arg[3] = static_cast<uint8_t>(bc >> 8);
+    for (int i = 0; i < 4; i++) wra1[i] = bus.peek(static_cast<uint16_t>(WRA1 + i));
+    uint8_t in_wra1[4];
+    std::memcpy(in_wra1, wra1, 4);
+    if (!compute(static_cast<Op>(op), arg, wra1, bcde)) {
+        check.count_deferred();
+        return false;
+    }
+
+    // Let the ROM run and compare at its return.
+    uint16_t sp       = cpu.get_sp();
+    uint16_t ret_addr = static_cast<uint16_t>(bus.peek(sp) | bus.peek(sp + 1) << 8);
+    if (check.checking(mode_, PROVE_CALLS)) {
+        Call c;
+        std::memcpy(c.in_arg, arg, 4);
+        std::memcpy(c.in_wra1, in_wra1, 4);
+        std::memcpy(c.wra1, wra1, 4);
+        std::memcpy(c.bcde, bcde, 4);
+        check.expect(ret_addr, sp, bus.get_global_t_states(), c);
+        return false;
+    }
+    check.count_native();
+
+    for (int i = 0; i < 4; i++) bus.write(static_cast<uint16_t>(WRA1 + i), wra1[i]);
+    cpu.set_bc(static_cast<uint16_t>(bcde[3] << 8 | bcde[2]));
+    cpu.set_de(static_cast<uint16_t>(bcde[1] << 8 | bcde[0]));
+
+    cpu.set_sp(sp + 2);
+    cpu.set_pc(ret_addr);
+    bus.add_ticks(cost_);
+    frame_ts += static_cast<uint64_t>(cost_);
+    return true;
+}
+
+// At the ROM's return: WRA1 (any zero equals any other) and BCDE.
+bool FloatHLE::same(const Call& c, bool report, const Z80& cpu, const Bus& bus, const char* name) {
+    uint8_t rom[4], rom_bcde[4];
+    for (int i = 0; i < 4; i++) rom[i] = bus.peek(static_cast<uint16_t>(WRA1 + i));
+    uint16_t bc = cpu.get_bc(), de = cpu.get_de();
+    rom_bcde[0] = static_cast<uint8_t>(de);
+    rom_bcde[1] = static_cast<uint8_t>(de >> 8);
+    rom_bcde[2] = static_cast<uint8_t>(bc);
+    rom_bcde[3] = static_cast<uint8_t>(bc >> 8);
+    if (((rom[3] == 0 && c.wra1[3] == 0) || std::memcmp(rom, c.wra1, 4) == 0) &&
+        std::memcmp(rom_bcde, c.bcde, 4) == 0)
+        return true;
+    if (report) {
+        std::fprintf(stderr,
+                     "[FPHLE] %s mismatch: BCDE=%02X%02X%02X%02X WRA1=%02X%02X%02X%02X"
+                     " → ROM %02X%02X%02X%02X BCDE %02X%02X%02X%02X,"
+                     " native %02X%02X%02X%02X BCDE %02X%02X%02X%02X\n",
+                     name,
+                     c.in_arg[3], c.in_arg[2], c.in_arg[1], c.in_arg[0],
+                     c.in_wra1[3], c.in_wra1[2], c.in_wra1[1], c.in_wra1[0],
+                     rom[3], rom[2], rom[1], rom[0],
+                     rom_bcde[3], rom_bcde[2], rom_bcde[1], rom_bcde[0],
+                     c.wra1[3], c.wra1[2], c.wra1[1], c.wra1[0],
+                     c.bcde[3], c.bcde[2], c.bcde[1], c.bcde[0]);
+    }
+    return false;
+}
+
+void FloatHLE::print_stats() const {
+    for (const Routine& r : routines_) r.check.print_stats(mode_);
+}
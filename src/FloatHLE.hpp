@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include "RomCheck.hpp"
+
+class Z80;
+class Bus;
+
+// Native stand-ins for the Level II BASIC single-precision arithmetic
+// routines (--fp-hle).
+//
+// BASIC's floating point is Microsoft Binary Format: exponent byte (0 =
+// zero, otherwise 2^(e-128)), then a 24-bit mantissa whose top bit is
+// replaced by the sign.  WRA1 (the accumulator) lives at 0x4121-0x4124,
+// LSB first; the second operand arrives in registers, B = exponent,
+// C = sign+MSB, D, E = LSB.
+//
+//   0x0716  FADD   WRA1 = BCDE + WRA1   (FSUB at 0x0713 negates, falls in)
+//   0x0847  FMULT  WRA1 = BCDE * WRA1
+//   0x08A2  FDIV   WRA1 = BCDE / WRA1
+//
+// The native code follows the ROM's algorithms step for step — 8-bit guard
+// byte, truncating alignment shifts, restoring division with one extra
+// quotient bit, round half up on the guard — so WRA1 and BCDE come out
+// bit-identical.  A, F and HL are scratch to the ROM's callers and are left
+// as they were on entry, not as the ROM would leave them; code that reads
+// them after one of these calls must run with --fp-hle off.  Anything near
+// the edges (overflow, underflow, divide by
+// zero) is left to the ROM, which raises its own errors.  SQR, SIN, LOG,
+// EXP etc. are polynomial evaluators built on these three and speed up
+// with them.
+//
+// Not replaced, deliberately: the double-precision routines (DEFDBL and #
+// variables, 8-byte operands), the transcendentals themselves and the
+// conversions (CINT, CSNG, number <-> text).  Single precision is BASIC's
+// default type and carries nearly all of its arithmetic; the
+// transcendentals already spend most of their time in the three entries
+// above, and replacing them whole would mean matching the ROM's
+// coefficient tables and term order bit for bit; the conversions are a
+// small share of the time.  Each would need its own step-for-step port and
+// a verify run against the ROM before it could be trusted.
+//
+// Each entry is only replaced if the ROM bytes there match the Microsoft
+// code, so a different ROM simply runs unassisted.  VERIFY and ON compare
+// WRA1 and BCDE at the ROM's return as described in RomCheck.hpp; ON trusts
+// each routine after PROVE_CALLS agreeing calls.
+class FloatHLE {
+public:
+    using Mode = HleMode;
+
+    static constexpr int DEFAULT_COST = 100;   // T-states charged per call
+    static constexpr uint64_t PROVE_CALLS = 100;   // ON: ROM-checked first, per routine
+
+    void set_mode(Mode m) { mode_ = m; }
+    Mode mode() const { return mode_; }
+    void set_cost(int t) { cost_ = t; }
+
+    // Check the ROM signatures.  Call after the ROM is loaded.
+    void attach(const Bus& bus);
+
+    // Call every step before cpu.step().  ON: if pc is a recognised entry
+    // and the operands are in range, computes the result, fakes the RET,
+    // charges the cost to bus and frame_ts and returns true (caller must
+    // skip cpu.step()).  VERIFY, and ON while the routine is not yet
+    // proven: tracks calls, returns false.
+    bool handle_intercept(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts);
+
+    // True if pc is a recognised entry, whatever the mode.
+    bool is_entry(uint16_t pc) const {
+        for (const Routine& r : routines_)
+            if (r.addr == pc && r.active) return true;
+        return false;
+    }
+
+    void print_stats() const;
+
+private:
+    enum Op { FADD, FMULT, FDIV, OPS };
+
+    // A ROM call being compared: its operands, for the mismatch report,
+    // and the native result.
+    struct Call {
+        uint8_t in_arg[4];
+        uint8_t in_wra1[4];
+        uint8_t wra1[4];
+        uint8_t bcde[4];
+    };
+    struct Routine {
+        uint16_t       addr;
+        bool           active;
+        RomCheck<Call> check;
+    };
+
+    Mode mode_ = Mode::OFF;
+    int  cost_ = DEFAULT_COST;
+    Routine routines_[OPS] = {
+        {0x0716, false, {"[FPHLE]", "FADD"}},
+        {0x0847, false, {"[FPHLE]", "FMULT"}},
+        {0x08A2, false, {"[FPHLE]", "FDIV"}},
+    };
+
+    static bool compute(Op op, const uint8_t arg[4], uint8_t wra1[4], uint8_t bcde[4]);
+    static bool same(const Call& c, bool report, const Z80& cpu, const Bus& bus, const char* name);
+};
@@ -0,0 +1,67 @@
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+void FramePacer::reset() {
+    next_    = clock::now() + PERIOD;
+    started_ = true;
+}
+
+void FramePacer::wait(double audio_queued) {
+    if (!started_) reset();
+
+    // Length of the frame that follows this one.  AUDIO: too much audio
+    // queued means we emulate faster than the device plays, so stretch it.
+    std::chrono::nanoseconds period = PERIOD;
+    if (mode_ == SyncMode::AUDIO && audio_queued >= 0.0) {
+        double err  = (audio_queued - AUDIO_TARGET_FRAMES) / AUDIO_TARGET_FRAMES;
+        double trim = std::clamp(err * AUDIO_GAIN, -MAX_AUDIO_TRIM, MAX_AUDIO_TRIM);
+        period = std::chrono::nanoseconds(
+            static_cast<int64_t>(static_cast<double>(PERIOD.count()) * (1.0 + trim)));
+    }
+
+    auto now = clock::now();
+    // SDL_RenderPresent already blocked until the vblank near the deadline:
+    // the display is the clock, follow it.
+    bool vblank = mode_ == SyncMode::VSYNC && now >= next_ - PERIOD / 8;
+    if (!vblank) {
+        // Coarse: let the OS sleep us most of the way...
+        if (now < next_ - SPIN_MARGIN)
+            std::this_thread::sleep_until(next_ - SPIN_MARGIN);
+        // ...fine: spin out the remainder.
+        while ((now = clock::now()) < next_)
+            std::this_thread::yield();
+    }
+
+    // Measured against the frame's own deadline, before VSYNC adopts the
+    // wake-up as the new one.
+    double late_us = std::chrono::duration<double, std::micro>(now - next_).count();
+    frames_++;
+    jitter_sum_ += std::fabs(late_us);
+    jitter_max_  = std::max(jitter_max_, std::fabs(late_us));
+    if (now - next_ >= LATE) late_++;
+    if (vblank) next_ = now;
+
+    // Absolute timeline: the next deadline is relative to this one, not to
+    // when we woke, so small overshoots don't accumulate into drift.
+    next_ += period;
+    if (now - next_ > MAX_LAG) {
+        dropped_ += static_cast<uint64_t>((now - next_) / period) + 1;
+        next_ = now + period;
+        resyncs_++;
+    }
+}
+
+void FramePacer::print_stats() const {
+    if (!frames_) return;
+    static const char* const NAMES[] = {"host", "audio", "vsync"};
+    std::fprintf(stderr,
+                 "[PACE] %s sync: %llu frames, jitter mean %.3f ms, max %.3f ms, %llu resyncs\n",
+                 NAMES[static_cast<int>(mode_)],
+                 static_cast<unsigned long long>(frames_),
+                 jitter_sum_ / static_cast<double>(frames_) / 1000.0,
+                 jitter_max_ / 1000.0,
+                 static_cast<unsigned long long>(resyncs_));
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+enum class SyncMode { HOST, AUDIO, VSYNC };
+
+// Holds the emulator to 60 frames per second of wall-clock time.
+//
+// Deadlines are absolute: frame N is due at start + N × period, so a late
+// wake-up shortens the next wait instead of pushing every later frame back.
+// Each wait sleeps in the OS until SPIN_MARGIN before the deadline, then
+// spins (yielding) for the remainder — OS sleeps overshoot by up to a
+// scheduler tick on a loaded box, the spin doesn't.
+//
+// The clock that defines "60 Hz" is selectable:
+//   HOST   steady_clock alone.
+//   AUDIO  the sound card: the period is nudged (±MAX_AUDIO_TRIM) so the
+//          SDL audio queue hovers at AUDIO_TARGET_FRAMES, i.e. emulation runs
+//          exactly as fast as the device consumes samples.
+//   VSYNC  the display: the renderer blocks in SDL_RenderPresent and the
+//          pacer adopts that wake-up as the frame boundary whenever it lands
+//          near the deadline.  Displays much faster than 60 Hz fall back to
+//          host pacing between vblanks.
+class FramePacer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::nanoseconds PERIOD{16'666'667};   // 60.0 Hz
+    static constexpr std::chrono::nanoseconds SPIN_MARGIN{1'500'000};
+    // Further behind than this (dialog, debugger stop, turbo) → rebase
+    // instead of racing to catch up.
+    static constexpr std::chrono::nanoseconds MAX_LAG = PERIOD * 4;
+    // Woken this far past the deadline: the frame missed its slot.
+    static constexpr std::chrono::nanoseconds LATE = PERIOD / 4;
+
+    static constexpr double AUDIO_TARGET_FRAMES = 2.0;   // ≈33 ms queued
+    static constexpr double AUDIO_GAIN          = 0.02;  // trim per frame of error
+    static constexpr double MAX_AUDIO_TRIM      = 0.02;  // ±2% of PERIOD
+
+    void     set_mode(SyncMode m) { mode_ = m; }
+    SyncMode mode() const { return mode_; }
+
+    // Start a fresh timeline: the next frame is due one period from now.
+    // Call after anything that stalled the loop or changed speed.
+    void reset();
+
+    // Block until the current frame's deadline, then schedule the next one.
+    // `audio_queued` is the audio backlog in frames (Sound::queued_frames());
+    // only AUDIO mode uses it, and a negative value (no device) means HOST.
+    void wait(double audio_queued = -1.0);
+
+    // One-line timing summary ("[PACE] ...") for the shutdown log.
+    void print_stats() const;
+
+    // Running totals for the HUD: frames that woke LATE or more past their
+    // deadline, and frame periods skipped when a resync gave up on them.
+    uint64_t late_frames()    const { return late_; }
+    uint64_t dropped_frames() const { return dropped_; }
+
+private:
+    SyncMode          mode_ = SyncMode::HOST;
+    clock::time_point next_{};
+    bool              started_ = false;
+
+    // Wake-up error statistics (absolute distance from the deadline)
+    uint64_t frames_      = 0;
+    uint64_t resyncs_     = 0;
+    double   jitter_sum_  = 0.0;   // µs
+    double   jitter_max_  = 0.0;   // µs
+    uint64_t late_        = 0;
+    uint64_t dropped_     = 0;
+};
@@ -1,8 +1,10 @@
 #include "KeyInjector.hpp"
 #include "cpu/z80.hpp"
+#include "cpu/Timing.hpp"
 #include "system/Bus.hpp"
-#include <fstream>
+#include "system/ZipReader.hpp"
 #include <iostream>
+#include <sstream>
 
 void KeyInjector::enqueue(const std::string& text) {
     for (unsigned char c : text) {
@@ -14,12 +16,13 @@ void KeyInjector::enqueue(const std::string& text) {
 }
 
 void KeyInjector::load_bas(const std::string& path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
+    std::vector<uint8_t> bytes;
+    if (!ZipReader::read(path, bytes, {".bas"})) {
         std::cerr << "[BAS] Failed to open: " << path << "\n";
         return;
     }
     enqueue("NEW\n");
+    std::istringstream file(std::string(bytes.begin(), bytes.end()));
     std::string line;
     int lines = 0;
     while (std::getline(file, line)) {
@@ -47,7 +50,7 @@ bool KeyInjector::handle_intercept(uint16_t pc, Z80& cpu, Bus& bus,
     cpu.set_sp(sp + 2);
     cpu.set_pc(ret_addr);
     cpu.set_a(ch);
-    bus.add_ticks(10);
-    frame_ts += 10;
+    bus.add_ticks(T_MAIN[0xC9]);   // the RET we stand in for
+    frame_ts += T_MAIN[0xC9];
     return true;
 }
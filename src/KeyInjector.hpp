@@ -22,6 +22,7 @@ public:
     void load_bas(const std::string& path);
 
     bool is_active() const { return !queue_.empty(); }
+    size_t pending() const { return queue_.size(); }
 
     // Discard all queued characters (call on emulator reset).
     void clear() { queue_ = std::queue<uint8_t>{}; }
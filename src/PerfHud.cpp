@@ -0,0 +1,96 @@
+#include "PerfHud.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+constexpr double Z80_MHZ = 1.77408;   // Model I clock
+
+const char* const SECTION_NAMES[PerfHud::SECTIONS] = {
+    "emulate", "render", "upload", "present", "audio", "sleep",
+};
+
+double ms(PerfHud::clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+}  // namespace
+
+void PerfHud::set_enabled(bool on) {
+    on_      = on;
+    started_ = false;   // the first pass after this starts a fresh window
+    lines_.clear();
+}
+
+void PerfHud::restart(clock::time_point now, uint64_t t_states, uint64_t late, uint64_t dropped) {
+    sum_.fill({});
+    max_.fill({});
+    loop_sum_      = loop_max_ = {};
+    window_start_  = loop_start_ = now;
+    passes_        = 0;
+    t_start_       = t_states;
+    late_start_    = late;
+    dropped_start_ = dropped;
+    audio_sum_     = 0.0;
+    started_       = true;
+}
+
+void PerfHud::end_loop(uint64_t t_states, double audio_queued, uint64_t late, uint64_t dropped) {
+    if (!on_) return;
+    clock::time_point now = clock::now();
+    if (!started_) {
+        time_.fill({});
+        restart(now, t_states, late, dropped);
+        return;
+    }
+
+    for (int s = 0; s < SECTIONS; s++) {
+        sum_[s] += time_[s];
+        max_[s]  = std::max(max_[s], time_[s]);
+    }
+    time_.fill({});
+    clock::duration loop = now - loop_start_;
+    loop_sum_  += loop;
+    loop_max_   = std::max(loop_max_, loop);
+    loop_start_ = now;
+    passes_++;
+    audio_sum_ += audio_queued;
+
+    if (now - window_start_ >= WINDOW) {
+        publish(now, t_states, audio_queued, late, dropped);
+        restart(now, t_states, late, dropped);
+    }
+}
+
+// Host milliseconds per pass of the loop, average and worst, then the
+// emulated clock and the pacer over the window.
+void PerfHud::publish(clock::time_point now, uint64_t t_states, double audio_queued,
+                      uint64_t late, uint64_t dropped) {
+    char buf[64];
+    double n = static_cast<double>(passes_);
+    lines_.clear();
+    lines_.push_back("host ms/pass     avg    max");
+
+    clock::duration timed{};
+    for (int s = 0; s < SECTIONS; s++) {
+        std::snprintf(buf, sizeof(buf), "%-12s %7.2f %6.2f", SECTION_NAMES[s],
+                      ms(sum_[s]) / n, ms(max_[s]));
+        lines_.push_back(buf);
+        timed += sum_[s];
+    }
+    std::snprintf(buf, sizeof(buf), "%-12s %7.2f", "other", ms(loop_sum_ - timed) / n);
+    lines_.push_back(buf);
+    std::snprintf(buf, sizeof(buf), "%-12s %7.2f %6.2f", "total", ms(loop_sum_) / n, ms(loop_max_));
+    lines_.push_back(buf);
+
+    double secs = std::chrono::duration<double>(now - window_start_).count();
+    double mhz  = static_cast<double>(t_states - t_start_) / secs / 1e6;
+    std::snprintf(buf, sizeof(buf), "%.3f MHz  %.2fx  %3.0f/s", mhz, mhz / Z80_MHZ, n / secs);
+    lines_.push_back(buf);
+
+    if (audio_queued < 0.0) std::snprintf(buf, sizeof(buf), "audio off");
+    else std::snprintf(buf, sizeof(buf), "audio queue %.1f frames", audio_sum_ / n);
+    lines_.push_back(buf);
+    std::snprintf(buf, sizeof(buf), "late %llu  dropped %llu",
+                  static_cast<unsigned long long>(late - late_start_),
+                  static_cast<unsigned long long>(dropped - dropped_start_));
+    lines_.push_back(buf);
+}
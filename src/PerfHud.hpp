@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// In-window performance HUD (F2, --hud): where the host's time goes, so a
+// stutter can be pinned on the core or on presentation at a glance.
+//
+// Each pass of Emulator::run() is split into sections timed with
+// steady_clock scopes: emulation (step_frame, run-ahead included), render
+// (VRAM → framebuffer → CRT post-processing), texture upload, present,
+// audio flush and the pacer's sleep; "other" is the rest of the loop
+// (events, title, boot cache).  Every WINDOW the averages and worst case
+// per pass are turned into text lines, with the emulated clock rate, the
+// speed factor, the audio queue depth and the pacer's late and dropped
+// frames over the window.  Display draws the lines over the top-right
+// corner of the screen.
+//
+// Off, a scope is a test of one bool; on, two clock reads.
+class PerfHud {
+public:
+    using clock = std::chrono::steady_clock;
+
+    enum Section { EMULATE, RENDER, UPLOAD, PRESENT, AUDIO, SLEEP, SECTIONS };
+
+    static constexpr clock::duration WINDOW = std::chrono::milliseconds(500);
+
+    // Times the enclosing block into `section` while the HUD is on.
+    class Scope {
+    public:
+        Scope(PerfHud& hud, Section section) : hud_(hud), section_(section) {
+            if (hud_.on_) t0_ = clock::now();
+        }
+        ~Scope() {
+            if (hud_.on_) hud_.time_[section_] += clock::now() - t0_;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        PerfHud&          hud_;
+        Section           section_;
+        clock::time_point t0_{};
+    };
+
+    void set_enabled(bool on);
+    bool enabled() const { return on_; }
+
+    // End of one pass of the emulator loop.  `t_states` is the emulated
+    // clock so far, `audio_queued` Sound::queued_frames() (negative: no
+    // device), `late` / `dropped` the pacer's running totals.
+    void end_loop(uint64_t t_states, double audio_queued, uint64_t late, uint64_t dropped);
+
+    // Text for Display, rebuilt every WINDOW.  Empty until the first.
+    const std::vector<std::string>& lines() const { return lines_; }
+
+private:
+    bool on_ = false;
+
+    // Current window
+    std::array<clock::duration, SECTIONS> time_{};      // this pass
+    std::array<clock::duration, SECTIONS> sum_{};
+    std::array<clock::duration, SECTIONS> max_{};
+    clock::duration   loop_sum_{}, loop_max_{};
+    clock::time_point window_start_{}, loop_start_{};
+    uint64_t          passes_ = 0;
+    uint64_t          t_start_ = 0, late_start_ = 0, dropped_start_ = 0;
+    double            audio_sum_ = 0.0;
+    bool              started_ = false;
+
+    std::vector<std::string> lines_;
+
+    void restart(clock::time_point now, uint64_t t_states, uint64_t late, uint64_t dropped);
+    void publish(clock::time_point now, uint64_t t_states, double audio_queued,
+                 uint64_t late, uint64_t dropped);
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Prove-then-trust bookkeeping for a native stand-in of one ROM routine
+// (FloatHLE, VideoHLE).
+//
+// OFF replaces nothing and checks nothing.  VERIFY replaces nothing either:
+// every call runs in the ROM, and at its return the ROM's result is
+// compared with what the native code would have produced, and its T-state
+// cost is measured.  ON starts out the same way and lets the native code
+// take over only once enough ROM calls have agreed with it.  A mismatch
+// leaves the routine to the ROM for the rest of the run, so a ROM that
+// differs from the one the native code was written against costs speed,
+// never results.
+enum class HleMode { OFF, ON, VERIFY };
+
+// `Call` is what the owner needs at the return to judge the ROM's result:
+// the native result and whatever the mismatch report prints.
+template <typename Call>
+class RomCheck {
+public:
+    static constexpr int MAX_REPORTS = 10;
+
+    // `tag` prefixes every message ("[FPHLE]"), `name` is the routine.
+    RomCheck(const char* tag, const char* name) : tag_(tag), name_(name) {}
+
+    const char* name() const { return name_; }
+
+    // True while a call to the routine must still run in the ROM and be
+    // compared: always in VERIFY, in ON until `prove` calls have agreed.
+    bool checking(HleMode mode, uint64_t prove) const {
+        return mode == HleMode::VERIFY || checked_ < prove;
+    }
+    // ON: a mismatch has left the routine to the ROM.
+    bool failed() const { return mismatch_ != 0; }
+    uint64_t checked() const { return checked_; }
+
+    void count_native()   { native_++; }
+    void count_deferred() { deferred_++; }
+
+    // A ROM call entered at T-state `t` with its return address on top of
+    // the stack at `sp`.
+    void expect(uint16_t ret, uint16_t sp, uint64_t t, const Call& call) {
+        pending_.push_back({ret, sp, t, call});
+    }
+
+    // Call every step (before the owner's own intercept) while calls are
+    // pending.  Drops calls abandoned by an error jump, whose stack has
+    // unwound past them, and completes those that have returned:
+    // same(call, report) compares the ROM's result with the native one and
+    // prints the details of a mismatch when `report` is set.
+    template <typename Same>
+    void check_return(uint16_t pc, uint16_t sp, uint64_t t, HleMode mode, Same same) {
+        while (!pending_.empty() && sp > static_cast<uint16_t>(pending_.back().sp + 2))
+            pending_.pop_back();
+
+        while (!pending_.empty() && pc == pending_.back().ret &&
+               sp == static_cast<uint16_t>(pending_.back().sp + 2)) {
+            Pending p = pending_.back();
+            pending_.pop_back();
+            rom_t_ += t - p.t_start;
+            checked_++;
+            if (same(p.call, reported_ < MAX_REPORTS)) continue;
+            mismatch_++;
+            reported_++;
+            if (mode == HleMode::ON && mismatch_ == 1)
+                std::fprintf(stderr, "%s %s: this ROM disagrees with the native routine — "
+                                     "left to the ROM\n", tag_, name_);
+        }
+    }
+
+    bool pending() const { return !pending_.empty(); }
+
+    void print_stats(HleMode mode) const {
+        if (mode == HleMode::ON && (native_ || deferred_ || checked_)) {
+            std::fprintf(stderr, "%s %s: %llu native, %llu checked against the ROM first, "
+                                 "%llu left to the ROM%s\n",
+                         tag_, name_,
+                         static_cast<unsigned long long>(native_),
+                         static_cast<unsigned long long>(checked_),
+                         static_cast<unsigned long long>(deferred_),
+                         mismatch_ ? " (native path off: mismatch)" : "");
+        } else if (mode == HleMode::VERIFY && checked_) {
+            std::fprintf(stderr, "%s %s: %llu checked, %llu mismatches, ROM mean %llu T-states\n",
+                         tag_, name_,
+                         static_cast<unsigned long long>(checked_),
+                         static_cast<unsigned long long>(mismatch_),
+                         static_cast<unsigned long long>(rom_t_ / checked_));
+        }
+    }
+
+private:
+    struct Pending {
+        uint16_t ret;
+        uint16_t sp;
+        uint64_t t_start;
+        Call     call;
+    };
+
+    const char* tag_;
+    const char* name_;
+    std::vector<Pending> pending_;
+
+    uint64_t native_   = 0;
+    uint64_t deferred_ = 0;
+    uint64_t checked_  = 0;
+    uint64_t mismatch_ = 0;
+    uint64_t rom_t_    = 0;     // T-states the ROM spent on checked calls
+    int      reported_ = 0;
+};
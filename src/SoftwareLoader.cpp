@@ -1,7 +1,9 @@
 #include "SoftwareLoader.hpp"
 #include "KeyInjector.hpp"
 #include "cpu/z80.hpp"
+#include "cpu/Timing.hpp"
 #include "system/Bus.hpp"
+#include "system/ZipReader.hpp"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -9,18 +11,11 @@
 #include <algorithm>
 #include <cstdio>
 
-extern "C" {
-// Suppress unused-function warnings from miniz's inline zlib-compat wrappers
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-function"
-#include "miniz.h"
-#pragma clang diagnostic pop
-}
-
 // ROM addresses this class intercepts
 static constexpr uint16_t ROM_SYSTEM_ENTRY = 0x02CE;  // LOPHD — SYSTEM loader entry
 static constexpr uint16_t ROM_SYNC_SEARCH  = 0x0293;  // CSRDON — CLOAD sync search
 static constexpr uint16_t ROM_WRITE_LEADER = 0x0284;  // CSAVE write-leader entry
+static constexpr uint16_t ROM_WRITE_BYTE   = 0x0264;  // CSOUT — write A to tape
 static constexpr uint16_t ROM_BASIC_READY  = 0x1A19;  // BASIC warm restart (READY prompt)
 static constexpr uint16_t ROM_FILENAME_PTR = 0x40A7;  // 2-byte ptr to 6-char filename in RAM
 static constexpr uint16_t ROM_CASIN_FIRST  = 0x0235;  // first call into CASIN (clock realign)
@@ -41,22 +36,36 @@ std::string SoftwareLoader::find_cas_file(const std::string& filename,
                                           const char* tag) {
     namespace fs = std::filesystem;
     std::cout << "[" << tag << "] Searching for: '" << filename << "'\n";
+
+    // An explicit path (plain, or through a zip — see ZipReader) wins.
+    std::string want_ext = file_ext(filename);
+    if ((want_ext == ".cas" || want_ext == ".bas") && ZipReader::resolve(filename))
+        return filename;
     if (!fs::exists("software")) return "";
 
     std::string lower = filename;
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
 
     std::vector<std::string> matches;
-    for (auto& e : fs::directory_iterator("software")) {
-        if (!e.is_regular_file()) continue;
-        std::string ext = file_ext(e.path().string());
-        if (ext != ".cas" && ext != ".bas") continue;
-        std::string stem = e.path().stem().string();
-        std::string stem_lower = stem;
+    auto consider = [&](const fs::path& p, const std::string& as) {
+        std::string ext = file_ext(p.string());
+        if (ext != ".cas" && ext != ".bas") return;
+        std::string stem_lower = p.stem().string();
         std::transform(stem_lower.begin(), stem_lower.end(),
                        stem_lower.begin(), ::tolower);
         if (lower.empty() || stem_lower.find(lower) == 0)
-            matches.push_back(e.path().string());
+            matches.push_back(as);
+    };
+    for (auto& e : fs::directory_iterator("software")) {
+        if (!e.is_regular_file()) continue;
+        if (file_ext(e.path().string()) == ".zip") {
+            // Entries of software/pack.zip are addressed as software/pack/<entry>
+            fs::path base = e.path().parent_path() / e.path().stem();
+            for (const auto& entry : ZipReader::list(e.path().string()))
+                consider(fs::path(entry), (base / entry).string());
+            continue;
+        }
+        consider(e.path(), e.path().string());
     }
     if (matches.empty()) {
         std::cout << "[" << tag << "] No match found for: '" << filename << "'\n";
@@ -68,9 +77,8 @@ std::string SoftwareLoader::find_cas_file(const std::string& filename,
 }
 
 bool SoftwareLoader::is_system_cas(const std::string& path) {
-    std::ifstream f(path, std::ios::binary);
-    if (!f.is_open()) return false;
-    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(f)), {});
+    std::vector<uint8_t> buf;
+    if (!ZipReader::read(path, buf)) return false;
     size_t i = 0;
     while (i < buf.size() && buf[i] == 0x00) i++;
     if (i >= buf.size() || buf[i] != 0xA5) return false;
@@ -80,13 +88,11 @@ bool SoftwareLoader::is_system_cas(const std::string& path) {
 
 bool SoftwareLoader::load_system_cas(const std::string& path,
                                      Bus& bus, Z80& cpu) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    std::vector<uint8_t> buf;
+    if (!ZipReader::read(path, buf)) {
         std::cerr << "[SYSTEM] Failed to open: " << path << "\n";
         return false;
     }
-    std::vector<uint8_t> buf(
-        (std::istreambuf_iterator<char>(file)), {});
 
     size_t i = 0;
     while (i < buf.size() && buf[i] == 0x00) i++;  // skip leader
@@ -315,6 +321,11 @@ void SoftwareLoader::on_cload_tracking(uint16_t pc, Z80& cpu, Bus& bus,
     }
 }
 
+bool SoftwareLoader::is_intercept(uint16_t pc) const {
+    return pc == ROM_SYSTEM_ENTRY || pc == ROM_SYNC_SEARCH || pc == ROM_WRITE_LEADER ||
+           (cmd_loaded_ && pc == 0x0028) || cload_active_;
+}
+
 void SoftwareLoader::on_csave_entry(uint16_t pc, Bus& bus) {
     if (pc != ROM_WRITE_LEADER) return;
     if (bus.get_cassette_state() != CassetteState::IDLE) return;
@@ -326,6 +337,26 @@ void SoftwareLoader::on_csave_entry(uint16_t pc, Bus& bus) {
               << (fname.empty() ? "" : " \"" + fname + "\"") << "\n";
 }
 
+bool SoftwareLoader::on_csave_byte(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts) {
+    if (pc != ROM_WRITE_BYTE || !fast_csave_) return false;
+    if (bus.get_cassette_state() != CassetteState::RECORDING) return false;
+    // push hl / push bc / push de / push af — anything else is not the
+    // Level II routine, so let it generate FSK as usual.
+    if (bus.peek(ROM_WRITE_BYTE)     != 0xE5 || bus.peek(ROM_WRITE_BYTE + 1) != 0xC5 ||
+        bus.peek(ROM_WRITE_BYTE + 2) != 0xD5 || bus.peek(ROM_WRITE_BYTE + 3) != 0xF5)
+        return false;
+
+    bus.record_byte(cpu.get_a());
+
+    uint16_t sp       = cpu.get_sp();
+    uint16_t ret_addr = bus.peek(sp) | (bus.peek(sp + 1) << 8);
+    cpu.set_sp(sp + 2);
+    cpu.set_pc(ret_addr);
+    bus.add_ticks(T_MAIN[0xC9]);   // the RET we stand in for
+    frame_ts += T_MAIN[0xC9];
+    return true;
+}
+
 // ============================================================================
 // CMD file loading (Phase 1 — init-time host-side loader)
 // ============================================================================
@@ -363,33 +394,9 @@ CmdSource SoftwareLoader::resolve_cmd_source(const std::string& arg) {
     if (fs::exists(arg) && fs::is_regular_file(arg))
         return { "", arg, fs::path(arg).parent_path().string() };
 
-    // 2. Walk path components: check if <prefix>.zip exists and contains <suffix>
-    fs::path p(arg);
-    fs::path suffix = p.filename();
-    fs::path parent = p.parent_path();
-    while (!parent.empty() && parent != parent.parent_path()) {
-        fs::path zip_candidate = fs::path(parent.string() + ".zip");
-        if (fs::exists(zip_candidate)) {
-            // Check if this zip contains the suffix entry (case-insensitive)
-            mz_zip_archive zip{};
-            if (mz_zip_reader_init_file(&zip, zip_candidate.string().c_str(), 0)) {
-                mz_uint n = mz_zip_reader_get_num_files(&zip);
-                std::string want = to_lower(suffix.string());
-                for (mz_uint i = 0; i < n; i++) {
-                    mz_zip_archive_file_stat st;
-                    if (!mz_zip_reader_file_stat(&zip, i, &st)) continue;
-                    if (to_lower(st.m_filename) == want) {
-                        mz_zip_reader_end(&zip);
-                        return { zip_candidate.string(), st.m_filename,
-                                 zip_candidate.parent_path().string() };
-                    }
-                }
-                mz_zip_reader_end(&zip);
-            }
-        }
-        suffix = fs::path(parent.filename()) / suffix;
-        parent = parent.parent_path();
-    }
+    // 2. A path through a zip: <prefix>.zip containing <suffix> (ZipReader)
+    if (auto zs = ZipReader::resolve(arg); zs && zs->from_zip())
+        return { zs->zip, zs->entry, fs::path(zs->zip).parent_path().string() };
 
     // 3. Bare name: search software/ for *.cmd prefix match
     if (fs::exists("software")) {
@@ -412,24 +419,16 @@ CmdSource SoftwareLoader::resolve_cmd_source(const std::string& arg) {
         for (auto& e : fs::directory_iterator("software")) {
             if (!e.is_regular_file()) continue;
             if (ext_lower(e.path().string()) != ".zip") continue;
-            mz_zip_archive zip{};
-            if (!mz_zip_reader_init_file(&zip, e.path().string().c_str(), 0))
-                continue;
-            mz_uint n = mz_zip_reader_get_num_files(&zip);
-            std::vector<std::pair<std::string,std::string>> hits; // {filename, rawname}
-            for (mz_uint i = 0; i < n; i++) {
-                mz_zip_archive_file_stat st;
-                if (!mz_zip_reader_file_stat(&zip, i, &st)) continue;
-                std::string fn = st.m_filename;
+            std::vector<std::string> hits;
+            for (const auto& fn : ZipReader::list(e.path().string())) {
                 if (ext_lower(fn) != ".cmd") continue;
                 std::string sl = to_lower(fs::path(fn).stem().string());
                 if (sl.find(lower_arg) == 0)
-                    hits.push_back({ fn, fn });
+                    hits.push_back(fn);
             }
-            mz_zip_reader_end(&zip);
             if (!hits.empty()) {
                 std::sort(hits.begin(), hits.end());
-                return { e.path().string(), hits.front().first,
+                return { e.path().string(), hits.front(),
                          e.path().parent_path().string() };
             }
         }
@@ -450,36 +449,8 @@ std::vector<uint8_t> SoftwareLoader::read_source_bytes(const CmdSource& src) {
     }
 
     // Extract from zip
-    mz_zip_archive zip{};
-    if (!mz_zip_reader_init_file(&zip, src.zip_path.c_str(), 0)) {
-        std::cerr << "[CMD] Cannot open zip: " << src.zip_path << "\n";
-        return {};
-    }
-    // locate the entry (case-insensitive)
-    std::string want = to_lower(src.entry);
-    mz_uint n = mz_zip_reader_get_num_files(&zip);
-    int idx = -1;
-    for (mz_uint i = 0; i < n; i++) {
-        mz_zip_archive_file_stat st;
-        if (!mz_zip_reader_file_stat(&zip, i, &st)) continue;
-        if (to_lower(st.m_filename) == want) { idx = (int)i; break; }
-    }
-    if (idx < 0) {
-        std::cerr << "[CMD] Entry '" << src.entry
-                  << "' not found in " << src.zip_path << "\n";
-        mz_zip_reader_end(&zip);
-        return {};
-    }
-    size_t sz = 0;
-    void* raw = mz_zip_reader_extract_to_heap(&zip, (mz_uint)idx, &sz, 0);
-    mz_zip_reader_end(&zip);
-    if (!raw) {
-        std::cerr << "[CMD] Extraction failed for: " << src.entry << "\n";
-        return {};
-    }
-    std::vector<uint8_t> buf(static_cast<uint8_t*>(raw),
-                              static_cast<uint8_t*>(raw) + sz);
-    mz_free(raw);
+    std::vector<uint8_t> buf;
+    if (!ZipReader::read(ZipReader::Source{src.zip_path, src.entry}, buf)) return {};
     return buf;
 }
 
@@ -625,26 +596,13 @@ std::vector<uint8_t> SoftwareLoader::find_sibling_bytes(const std::string& name)
 
     if (cmd_source_.from_zip()) {
         // Search zip for any entry whose filename (base) matches case-insensitively
-        mz_zip_archive zip{};
-        if (!mz_zip_reader_init_file(&zip, cmd_source_.zip_path.c_str(), 0))
-            return {};
-        mz_uint n = mz_zip_reader_get_num_files(&zip);
-        int idx = -1;
-        for (mz_uint i = 0; i < n; i++) {
-            mz_zip_archive_file_stat st;
-            if (!mz_zip_reader_file_stat(&zip, i, &st)) continue;
-            std::string fn = to_lower(fs::path(st.m_filename).filename().string());
-            if (fn == lower_name) { idx = (int)i; break; }
+        for (const auto& fn : ZipReader::list(cmd_source_.zip_path)) {
+            if (to_lower(fs::path(fn).filename().string()) != lower_name) continue;
+            std::vector<uint8_t> buf;
+            if (!ZipReader::read(ZipReader::Source{cmd_source_.zip_path, fn}, buf)) return {};
+            return buf;
         }
-        if (idx < 0) { mz_zip_reader_end(&zip); return {}; }
-        size_t sz = 0;
-        void* raw = mz_zip_reader_extract_to_heap(&zip, (mz_uint)idx, &sz, 0);
-        mz_zip_reader_end(&zip);
-        if (!raw) return {};
-        std::vector<uint8_t> buf(static_cast<uint8_t*>(raw),
-                                  static_cast<uint8_t*>(raw) + sz);
-        mz_free(raw);
-        return buf;
+        return {};
     }
 
     // Filesystem: search the same directory as the CMD file
@@ -57,6 +57,18 @@ public:
     // CSAVE write-leader entry (0x0284): start cassette recording.
     void on_csave_entry(uint16_t pc, Bus& bus);
 
+    // Cassette write-byte (0x0264) while recording: append A to the tape
+    // directly instead of generating 500-baud FSK.  The ROM routine saves
+    // and restores every register, so faking its RET leaves them exact.
+    // Returns true (caller must skip cpu.step()) when it handled the call.
+    bool on_csave_byte(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts);
+    void set_fast_csave(bool on) { fast_csave_ = on; }
+
+    // True if stepping at `pc` could trigger one of the intercepts above
+    // (entry points, RST 28h after --cmd, a CLOAD being tracked), i.e. touch
+    // host files or loader state.  Run-ahead stops speculating here.
+    bool is_intercept(uint16_t pc) const;
+
 private:
     // --- CMD loader state ---
     bool      cmd_loaded_  = false;
@@ -79,6 +91,7 @@ private:
     bool   cload_active_     = false;
     bool   cload_realigned_  = false;
     int    cload_byte_count_ = 0;
+    bool   fast_csave_       = true;     // --fsk-csave clears
     size_t cload_sync_pos_   = 0;
     std::string cli_autoload_path_;
     bool   cli_autorun_      = false;
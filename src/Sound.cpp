@@ -88,6 +88,12 @@ void Sound::flush() {
     buf_.clear();
 }
 
+double Sound::queued_frames() const {
+    if (device_ == 0) return -1.0;
+    double samples = SDL_GetQueuedAudioSize(device_) / static_cast<double>(sizeof(int16_t));
+    return samples / (SAMPLE_RATE / 60.0);
+}
+
 void Sound::clear() {
     buf_.clear();
     lp_state_ = 0.0f;  // reset filters so first real sample doesn't pop
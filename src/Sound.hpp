@@ -55,6 +55,10 @@ public:
     // game audio.
     void clear();
 
+    // Audio queued in the SDL device, in video frames (1/60 s) — the
+    // backlog FramePacer steers toward in --sync audio.  -1 if no device.
+    double queued_frames() const;
+
     static constexpr int MAX_QUEUED_FRAMES = 4;  // max ~67 ms of audio queued
 
 private:
@@ -0,0 +1,473 @@
+#include "TimeTravel.hpp"
+#include "Emulator.hpp"
+#include "cpu/Disasm.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+static constexpr uint64_t NONE = ~0ull;
+
+static const char HELP[] =
+    "  rs [n]          step back n steps (default 1)\n"
+    "  s [n]           step forward n steps, up to the present\n"
+    "  rc              run back to the previous breakpoint hit\n"
+    "  lw <addr>       go back to the last write to addr\n"
+    "  b [addr]        set or clear a breakpoint; alone, list them\n"
+    "  g <step>        go to a step;  p  back to the present\n"
+    "  r               registers\n"
+    "  m <addr> [n]    memory (n bytes, default 64)\n"
+    "  d [addr] [n]    disassemble (default: PC, 8 instructions)\n"
+    "  i               history kept\n"
+    "  c               continue running from here (drops the old future)\n"
+    "Addresses are hex.  A step is one instruction, or one native routine\n"
+    "standing in for ROM code (--fp-hle, --video-hle, --fast-disk, $KEY).\n";
+
+static bool has(const Bus::AddrBits& bits, uint16_t addr) {
+    return bits[addr >> 6] >> (addr & 63) & 1;
+}
+
+static bool parse(const std::string& s, int base, uint64_t& out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    out = std::strtoull(s.c_str(), &end, base);
+    return *end == '\0';
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+void TimeTravel::set_seconds(int seconds) {
+    max_checkpoints_ = static_cast<size_t>(seconds) * 2;
+    emu_.bus_.set_write_log(enabled() ? &writes_ : nullptr);
+}
+
+void TimeTravel::clear() {
+    checkpoints_.clear();
+    first_frame_ += frames_.size();
+    frames_.clear();
+    executed_ = {};
+    broken_   = false;
+}
+
+void TimeTravel::begin_frame(uint64_t t_budget) {
+    Emulator& e = emu_;
+    // Tape I/O and loader intercepts act from outside the step loop;
+    // nothing before them replays.  Record again once the tape is idle.
+    bool tape = e.bus_.get_cassette_state() != CassetteState::IDLE;
+    if (broken_ || tape) clear();
+    if (tape) return;
+
+    Frame f;
+    f.step   = step_;
+    f.budget = t_budget;
+    std::memcpy(f.keys, e.keyboard_matrix_, sizeof(f.keys));
+    if (e.injector_.pending() != injector_pending_)
+        f.injector = std::make_unique<KeyInjector>(e.injector_);
+    frames_.push_back(std::move(f));
+
+    if (checkpoints_.empty() ||
+        e.total_ticks_ - checkpoints_.back().total_ticks >= CHECKPOINT_T)
+        checkpoint(first_frame_ + frames_.size() - 1);
+}
+
+void TimeTravel::end_frame(uint64_t frame_ts) {
+    if (!frames_.empty()) frames_.back().used = frame_ts;
+    injector_pending_ = emu_.injector_.pending();
+}
+
+void TimeTravel::flush_bits() {
+    if (!checkpoints_.empty()) {
+        Checkpoint& c = checkpoints_.back();
+        for (size_t i = 0; i < executed_.size(); i++) {
+            c.executed[i] |= executed_[i];
+            c.written[i]  |= writes_.written[i];
+        }
+    }
+    executed_ = {};
+    writes_.written = {};
+}
+
+void TimeTravel::checkpoint(uint64_t frame) {
+    flush_bits();
+    Emulator& e = emu_;
+    Checkpoint c;
+    c.cpu = e.cpu_.save_state();
+    e.bus_.save_state(*c.bus);
+    c.injector  = e.injector_;
+    c.fp        = e.float_hle_;
+    c.video     = e.video_hle_;
+    c.fast_disk = e.fast_disk_;
+    // Images change rarely: share the previous checkpoint's bytes while the
+    // drive's write generation is unchanged.  Host-directory drives write
+    // through to the host and are left alone.
+    for (int d = 0; d < FDC::DRIVES; d++) {
+        uint64_t gen = e.bus_.fdc().write_generation(d);
+        if (gen == 0) continue;
+        c.disk_gen[d] = gen;
+        if (!checkpoints_.empty() && checkpoints_.back().disk_gen[d] == gen)
+            c.disks[d] = checkpoints_.back().disks[d];
+        else
+            c.disks[d] = ImageCache::intern(e.bus_.fdc().image_bytes(d));
+    }
+    c.total_ticks = e.total_ticks_;
+    c.prev_pc     = e.prev_pc_;
+    c.step        = step_;
+    c.frame       = frame;
+    checkpoints_.push_back(std::move(c));
+
+    while (checkpoints_.size() > max_checkpoints_) {
+        checkpoints_.pop_front();
+        while (first_frame_ < checkpoints_.front().frame) {
+            frames_.pop_front();
+            first_frame_++;
+        }
+    }
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+// Last checkpoint at or before `step` (not before the first).
+size_t TimeTravel::interval_of(uint64_t step) const {
+    auto it = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), step,
+                               [](uint64_t s, const Checkpoint& c) { return s < c.step; });
+    return it == checkpoints_.begin() ? 0 : static_cast<size_t>(it - checkpoints_.begin()) - 1;
+}
+
+uint64_t TimeTravel::interval_end(size_t i) const {
+    return i + 1 < checkpoints_.size() ? checkpoints_[i + 1].step : step_;
+}
+
+void TimeTravel::restore(size_t i) {
+    Emulator& e = emu_;
+    const Checkpoint& c = checkpoints_[i];
+    // Remount (before Bus::load_state restores the FDC) only drives the
+    // guest has written to since.  Remounting clears the dirty flag, but the
+    // rewound image no longer matches the file, so it still needs saving.
+    for (int d = 0; d < FDC::DRIVES; d++) {
+        uint64_t gen = e.bus_.fdc().write_generation(d);
+        if (c.disks[d] && gen != 0 && gen != c.disk_gen[d]) {
+            std::string name = e.bus_.fdc().get_disk_name(d);
+            if (e.bus_.fdc().load_disk_bytes(d, *c.disks[d], name))
+                e.bus_.fdc().mark_rewound(d, c.disk_gen[d]);
+        }
+    }
+    e.cpu_.load_state(c.cpu);
+    e.bus_.load_state(*c.bus);
+    e.injector_    = c.injector;
+    e.float_hle_   = c.fp;
+    e.video_hle_   = c.video;
+    e.fast_disk_   = c.fast_disk;
+    e.total_ticks_ = c.total_ticks;
+    e.prev_pc_     = c.prev_pc;
+
+    pos_      = c.step;
+    frame_    = c.frame;
+    frame_ts_ = 0;
+    std::memcpy(e.keyboard_matrix_, frame(frame_).keys, sizeof(e.keyboard_matrix_));
+}
+
+void TimeTravel::enter_frame(uint64_t n) {
+    Emulator& e = emu_;
+    const Frame& f = frame(n);
+    frame_    = n;
+    frame_ts_ = 0;
+    std::memcpy(e.keyboard_matrix_, f.keys, sizeof(e.keyboard_matrix_));
+    if (f.injector) e.injector_ = *f.injector;
+}
+
+bool TimeTravel::replay(uint64_t target, const std::function<bool()>& probe) {
+    Emulator& e = emu_;
+    bool ok = true;
+    // As for run-ahead: no trace, no sound, no HLE verify bookkeeping, and
+    // replayed history stays out of the coverage and the bus counts.
+    Coverage* cov   = e.cpu_.coverage();
+    BusStats* stats = e.bus_.stats();
+    e.cpu_.set_coverage(nullptr);
+    e.bus_.set_stats(nullptr);
+    e.speculating_ = true;
+    while (!(probe && probe()) && pos_ < target) {
+        while (frame_ts_ >= frame(frame_).budget) {
+            if (frame_ + 1 >= first_frame_ + frames_.size()) { ok = false; break; }
+            enter_frame(frame_ + 1);
+        }
+        if (!ok || !e.step_once(frame_ts_)) { ok = false; break; }
+        pos_++;
+    }
+    e.speculating_  = false;
+    e.spec_aborted_ = false;
+    e.cpu_.set_coverage(cov);
+    e.bus_.set_stats(stats);
+    if (!ok)
+        std::fprintf(stderr, "[REWIND] Replay stopped at step %llu: history does not replay\n",
+                     static_cast<unsigned long long>(pos_));
+    return ok;
+}
+
+bool TimeTravel::go_to(uint64_t target) {
+    target = std::clamp(target, checkpoints_.front().step, step_);
+    size_t i = interval_of(target);
+    // Forward within the current interval needs no restore
+    if (target < pos_ || i != interval_of(pos_)) restore(i);
+    return replay(target);
+}
+
+// ============================================================================
+// SEARCHES
+// ============================================================================
+// Intervals newest first, replaying only those that executed a breakpoint
+// address.  The hit nearest before the current position wins.
+void TimeTravel::reverse_continue() {
+    if (breakpoints_.empty()) { std::printf("No breakpoints (b <addr>)\n"); return; }
+    Emulator& e = emu_;
+    uint64_t from  = pos_;
+    uint64_t found = NONE;
+    for (size_t i = interval_of(from) + 1; i-- > 0 && found == NONE;) {
+        const Checkpoint& c = checkpoints_[i];
+        if (c.step >= from) continue;
+        bool maybe = false;
+        for (uint16_t bp : breakpoints_) maybe |= has(c.executed, bp);
+        if (!maybe) continue;
+
+        uint64_t end = std::min(interval_end(i), from);
+        restore(i);
+        replay(end, [&] {
+            if (pos_ < end && breakpoints_.count(e.cpu_.get_pc())) found = pos_;
+            return false;
+        });
+    }
+    if (found == NONE) {
+        go_to(from);
+        std::printf("No breakpoint hit in the history\n");
+        return;
+    }
+    go_to(found);
+    std::printf("Breakpoint %04X, %llu steps back\n", e.cpu_.get_pc(),
+                static_cast<unsigned long long>(from - found));
+    show_position();
+}
+
+// Same walk over the written bits, with a write watch on addr.  Stops
+// before the step that wrote, so that instruction is the one shown.
+void TimeTravel::last_write(uint16_t addr) {
+    Emulator& e = emu_;
+    uint64_t from  = pos_;
+    uint64_t found = NONE;
+    uint8_t  value = 0;
+    writes_.watch = addr;
+    for (size_t i = interval_of(from) + 1; i-- > 0 && found == NONE;) {
+        const Checkpoint& c = checkpoints_[i];
+        if (c.step >= from || !has(c.written, addr)) continue;
+
+        uint64_t end = std::min(interval_end(i), from);
+        restore(i);
+        writes_.watch_hit = false;
+        replay(end, [&] {
+            if (std::exchange(writes_.watch_hit, false)) {
+                found = pos_ - 1;
+                value = e.bus_.peek(addr);
+            }
+            return false;
+        });
+    }
+    writes_.watch = -1;
+    if (found == NONE) {
+        go_to(from);
+        std::printf("No write to %04X in the history\n", addr);
+        return;
+    }
+    go_to(found);
+    std::printf("%04X written %llu steps back: %02X -> %02X by\n", addr,
+                static_cast<unsigned long long>(from - found), e.bus_.peek(addr), value);
+    show_position();
+}
+
+// ============================================================================
+// CONSOLE
+// ============================================================================
+void TimeTravel::console() {
+    Emulator& e = emu_;
+    if (checkpoints_.empty()) {
+        std::fprintf(stderr, "[REWIND] No history yet (reset, disk mounts and tape I/O restart it)\n");
+        return;
+    }
+    flush_bits();
+    uint8_t live_keys[8];
+    std::memcpy(live_keys, e.keyboard_matrix_, sizeof(live_keys));
+    pos_      = step_;
+    frame_    = first_frame_ + frames_.size() - 1;
+    frame_ts_ = frames_.back().used;
+
+    std::printf("[REWIND] Emulation stopped — h for help, c to continue\n");
+    show_history();
+    show_position();
+
+    std::string line;
+    while (true) {
+        std::printf("rewind> ");
+        std::fflush(stdout);
+        if (!std::getline(std::cin, line)) break;
+        std::istringstream in(line);
+        std::string cmd, a1, a2;
+        in >> cmd >> a1 >> a2;
+        uint64_t n = 0, m = 0;
+
+        if (cmd.empty()) {
+            continue;
+        } else if (cmd == "c" || cmd == "q") {
+            break;
+        } else if (cmd == "h" || cmd == "?") {
+            std::printf("%s", HELP);
+        } else if (cmd == "rs" || cmd == "s") {
+            if (a1.empty()) n = 1;
+            else if (!parse(a1, 10, n)) { std::printf("rs/s [count]\n"); continue; }
+            if (cmd == "s" && pos_ == step_) {
+                std::printf("At the present — c continues running\n");
+                continue;
+            }
+            go_to(cmd == "rs" ? (pos_ > n ? pos_ - n : 0) : pos_ + std::min(n, step_ - pos_));
+            show_position();
+        } else if (cmd == "g") {
+            if (!parse(a1, 10, n)) { std::printf("g <step>\n"); continue; }
+            go_to(n);
+            show_position();
+        } else if (cmd == "p") {
+            go_to(step_);
+            show_position();
+        } else if (cmd == "rc") {
+            reverse_continue();
+        } else if (cmd == "lw") {
+            if (!parse(a1, 16, n) || n > 0xFFFF) { std::printf("lw <addr>\n"); continue; }
+            last_write(static_cast<uint16_t>(n));
+        } else if (cmd == "b") {
+            if (a1.empty()) {
+                for (uint16_t bp : breakpoints_) std::printf("  %04X\n", bp);
+                if (breakpoints_.empty()) std::printf("No breakpoints\n");
+                continue;
+            }
+            if (!parse(a1, 16, n) || n > 0xFFFF) { std::printf("b <addr>\n"); continue; }
+            uint16_t bp = static_cast<uint16_t>(n);
+            bool set = breakpoints_.insert(bp).second;
+            if (!set) breakpoints_.erase(bp);
+            std::printf("Breakpoint %04X %s\n", bp, set ? "set" : "cleared");
+        } else if (cmd == "r") {
+            show_registers();
+        } else if (cmd == "m") {
+            if (!parse(a1, 16, n) || n > 0xFFFF) { std::printf("m <addr> [n]\n"); continue; }
+            if (a2.empty() || !parse(a2, 10, m)) m = 64;
+            show_memory(static_cast<uint16_t>(n), static_cast<int>(std::min<uint64_t>(m, 4096)));
+        } else if (cmd == "d") {
+            n = e.cpu_.get_pc();
+            if (!a1.empty() && (!parse(a1, 16, n) || n > 0xFFFF)) { std::printf("d [addr] [n]\n"); continue; }
+            if (a2.empty() || !parse(a2, 10, m)) m = 8;
+            show_disasm(static_cast<uint16_t>(n), static_cast<int>(std::min<uint64_t>(m, 256)));
+        } else if (cmd == "i") {
+            show_history();
+        } else {
+            std::printf("Unknown command '%s' — h for help\n", cmd.c_str());
+        }
+        e.display_.render_frame(e.bus_);
+    }
+
+    resume();
+    std::memcpy(e.keyboard_matrix_, live_keys, sizeof(live_keys));
+    std::printf("[REWIND] Running from step %llu\n", static_cast<unsigned long long>(step_));
+}
+
+// Continue from the travel position.  In the past, the recorded future is
+// dropped and the rest of the current frame runs (and records) with its
+// logged budget, so the main loop picks up on a frame boundary.
+void TimeTravel::resume() {
+    Emulator& e = emu_;
+    writes_.written = {};   // replays, already accounted for
+    executed_ = {};
+    if (pos_ == step_) return;
+
+    while (first_frame_ + frames_.size() > frame_ + 1) frames_.pop_back();
+    while (checkpoints_.back().frame > frame_) checkpoints_.pop_back();
+    // The interval now mixes two futures; keep it a candidate for every search
+    checkpoints_.back().executed.fill(~0ull);
+    checkpoints_.back().written.fill(~0ull);
+    step_ = pos_;
+
+    uint64_t budget = frame(frame_).budget;
+    while (frame_ts_ < budget) {
+        uint16_t pc = e.cpu_.get_pc();
+        on_step(pc, e.loader_.is_intercept(pc));
+        if (!e.step_once(frame_ts_)) break;
+    }
+    end_frame(frame_ts_);
+}
+
+// ============================================================================
+// DISPLAY
+// ============================================================================
+void TimeTravel::show_position() const {
+    const Emulator& e = emu_;
+    uint16_t pc = e.cpu_.get_pc();
+    uint8_t bytes[Disasm::MAX_LEN];
+    for (int i = 0; i < Disasm::MAX_LEN; i++) bytes[i] = e.bus_.peek(static_cast<uint16_t>(pc + i));
+    char text[Disasm::TEXT_LEN];
+    Disasm::decode(bytes, pc, text, sizeof(text));
+    Z80::State s = e.cpu_.save_state();
+    std::printf("step %llu (%llu back)  %04X  %-20s AF=%02X%02X BC=%04X DE=%04X HL=%04X SP=%04X\n",
+                static_cast<unsigned long long>(pos_),
+                static_cast<unsigned long long>(step_ - pos_), pc, text,
+                s.reg.a, s.reg.f, s.reg.bc, s.reg.de, s.reg.hl, s.reg.sp);
+}
+
+void TimeTravel::show_registers() const {
+    Z80::State s = emu_.cpu_.save_state();
+    const auto& r = s.reg;
+    std::printf("AF =%02X%02X BC =%04X DE =%04X HL =%04X IX=%04X IY=%04X\n"
+                "AF'=%02X%02X BC'=%04X DE'=%04X HL'=%04X SP=%04X PC=%04X\n"
+                "I=%02X R=%02X IM %d  IFF1=%d IFF2=%d%s  flags %c%c-%c-%c%c%c  T=%llu\n",
+                r.a, r.f, r.bc, r.de, r.hl, r.ix, r.iy,
+                r.a2, r.f2, r.bc2, r.de2, r.hl2, r.sp, r.pc,
+                r.i, r.r, r.im, r.iff1, r.iff2, r.halted ? "  HALT" : "",
+                r.f & 0x80 ? 'S' : '-', r.f & 0x40 ? 'Z' : '-', r.f & 0x10 ? 'H' : '-',
+                r.f & 0x04 ? 'P' : '-', r.f & 0x02 ? 'N' : '-', r.f & 0x01 ? 'C' : '-',
+                static_cast<unsigned long long>(emu_.total_ticks_));
+}
+
+void TimeTravel::show_memory(uint16_t addr, int len) const {
+    for (int row = 0; row < len; row += 16) {
+        uint16_t a = static_cast<uint16_t>(addr + row);
+        std::printf("%04X ", a);
+        char ascii[17] = {};
+        for (int i = 0; i < 16; i++) {
+            uint8_t b = emu_.bus_.peek(static_cast<uint16_t>(a + i));
+            std::printf(" %02X", b);
+            ascii[i] = (b >= 0x20 && b < 0x7F) ? static_cast<char>(b) : '.';
+        }
+        std::printf("  %s\n", ascii);
+    }
+}
+
+void TimeTravel::show_disasm(uint16_t addr, int count) const {
+    uint16_t pc = emu_.cpu_.get_pc();
+    for (int n = 0; n < count; n++) {
+        uint8_t bytes[Disasm::MAX_LEN];
+        for (int i = 0; i < Disasm::MAX_LEN; i++)
+            bytes[i] = emu_.bus_.peek(static_cast<uint16_t>(addr + i));
+        char text[Disasm::TEXT_LEN];
+        int len = Disasm::decode(bytes, addr, text, sizeof(text));
+        char hex[Disasm::MAX_LEN * 3 + 1] = {};
+        for (int i = 0; i < len; i++) std::snprintf(hex + i * 3, 4, "%02X ", bytes[i]);
+        std::printf("%s %04X  %-12s %s\n", addr == pc ? "=>" : "  ", addr, hex, text);
+        addr = static_cast<uint16_t>(addr + len);
+    }
+}
+
+void TimeTravel::show_history() const {
+    size_t bytes = checkpoints_.size() * (sizeof(Checkpoint) + sizeof(Bus::State)) +
+                   frames_.size() * sizeof(Frame);
+    std::printf("History: steps %llu-%llu, about %.1f s emulated, %zu checkpoints (%.1f MB)\n",
+                static_cast<unsigned long long>(checkpoints_.front().step),
+                static_cast<unsigned long long>(step_),
+                checkpoints_.size() * 0.5, checkpoints_.size(), bytes / 1048576.0);
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "system/Bus.hpp"
+#include "cpu/z80.hpp"
+#include "fdc/FastDisk.hpp"
+#include "fdc/ImageCache.hpp"
+#include "KeyInjector.hpp"
+#include "FloatHLE.hpp"
+#include "VideoHLE.hpp"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <set>
+
+class Emulator;
+
+// Reverse execution (--rewind <seconds>): step and run backwards through
+// the last few minutes of emulation.
+//
+// While recording, a checkpoint of the whole machine (Z80::State,
+// Bus::State, the host-side helpers and the disk contents) is kept every
+// half second of emulated time, and every frame logs its inputs: the
+// T-state budget, the keyboard matrix and, when the host queued keystrokes,
+// the injector.  The step loop is deterministic given those, so any earlier
+// instruction is reached by restoring the checkpoint before it and
+// replaying at most half a second — a few milliseconds of host time.
+//
+// Position is counted in steps: one pass of the emulator loop, an
+// instruction or a host intercept standing in for a ROM routine.
+//
+// Backwards searches walk the checkpoint intervals newest first.  Each
+// interval carries bitmaps of the addresses executed and written in it
+// (16KB), so "last hit of breakpoint" and "last write to address" replay
+// only the interval that holds the answer.
+//
+// Reset, warm boot, mounting a disk, cassette activity and the loader
+// intercepts (SYSTEM/CLOAD/CSAVE, CMD SVCs) act on the machine from
+// outside step_frame() and cannot be replayed: history restarts after them.
+//
+// F11 stops the emulator and opens a console on stdin (see HELP in
+// TimeTravel.cpp).  The window shows the screen at the current position.
+// Continuing from the past finishes that frame and discards the old
+// future: execution goes on from there.
+class TimeTravel {
+public:
+    static constexpr uint64_t CHECKPOINT_T = 29498 * 30;   // half a second
+
+    explicit TimeTravel(Emulator& emu) : emu_(emu) {}
+
+    // Keep `seconds` of emulated time (0 = off).
+    void set_seconds(int seconds);
+    bool enabled() const { return max_checkpoints_ > 0; }
+
+    // Forget everything: the machine was changed from outside.
+    void clear();
+
+    // Recording, from Emulator::step_frame() outside run-ahead.
+    void begin_frame(uint64_t t_budget);
+    // `host_intercept`: pc is a loader intercept (SoftwareLoader::is_intercept).
+    void on_step(uint16_t pc, bool host_intercept) {
+        ++step_;
+        executed_[pc >> 6] |= 1ull << (pc & 63);
+        broken_ |= host_intercept;
+    }
+    void end_frame(uint64_t frame_ts);
+
+    // Interactive console.  Returns when the user continues or quits.
+    void console();
+
+private:
+    using AddrBits = Bus::AddrBits;
+
+    struct Checkpoint {
+        Z80::State                  cpu;
+        std::unique_ptr<Bus::State> bus = std::make_unique<Bus::State>();
+        KeyInjector                 injector;
+        FloatHLE                    fp;
+        VideoHLE                    video;
+        FastDisk                    fast_disk;
+        ImageCache::Bytes           disks[FDC::DRIVES];
+        uint64_t                    disk_gen[FDC::DRIVES] = {};
+        uint64_t                    total_ticks = 0;
+        uint16_t                    prev_pc     = 0;
+        uint64_t                    step  = 0;
+        uint64_t                    frame = 0;
+        AddrBits                    executed{};   // in the interval that follows
+        AddrBits                    written{};
+    };
+    struct Frame {
+        uint64_t                     step   = 0;   // first step
+        uint64_t                     budget = 0;
+        uint64_t                     used   = 0;   // frame_ts at the end
+        uint8_t                      keys[8] = {};
+        std::unique_ptr<KeyInjector> injector;     // host enqueued before it
+    };
+
+    Emulator& emu_;
+    size_t    max_checkpoints_ = 0;
+
+    std::deque<Checkpoint> checkpoints_;
+    std::deque<Frame>      frames_;
+    uint64_t first_frame_ = 0;    // number of frames_.front()
+    uint64_t step_        = 0;    // steps recorded (the present)
+    AddrBits executed_{};         // since the last checkpoint
+    Bus::WriteLog writes_;        // attached to the bus while enabled
+    size_t   injector_pending_ = 0;
+    bool     broken_ = false;     // host event this frame: restart history
+
+    // Travel position.  frame_ts_ is how far into frame frame_ the
+    // machine is; pos_ == step_ is the present.
+    uint64_t pos_      = 0;
+    uint64_t frame_    = 0;
+    uint64_t frame_ts_ = 0;
+
+    std::set<uint16_t> breakpoints_;
+
+    void checkpoint(uint64_t frame);
+    void flush_bits();
+    Frame& frame(uint64_t n) { return frames_[n - first_frame_]; }
+    size_t interval_of(uint64_t step) const;
+    uint64_t interval_end(size_t i) const;
+
+    // Replay from the current position to step `target`.  `probe`, if set,
+    // is called at every position on the way, the first and last included;
+    // replay stops early when it returns true.  False if history ran out.
+    bool replay(uint64_t target, const std::function<bool()>& probe = {});
+    void restore(size_t i);
+    bool go_to(uint64_t target);
+    void enter_frame(uint64_t n);
+
+    void reverse_continue();
+    void last_write(uint16_t addr);
+    void resume();
+
+    void show_position() const;
+    void show_registers() const;
+    void show_memory(uint16_t addr, int len) const;
+    void show_disasm(uint16_t addr, int count) const;
+    void show_history() const;
+};
@@ -0,0 +1,124 @@
+#include "VideoHLE.hpp"
+#include "cpu/z80.hpp"
+#include "system/Bus.hpp"
+#include <cstdio>
+#include <cstring>
+
+static constexpr int LINE = 64;
+
+// ============================================================================
+// NATIVE DRIVER
+// ============================================================================
+bool VideoHLE::plain_state(const Bus& bus) {
+    uint16_t driver = static_cast<uint16_t>(bus.peek(DCB_DRIVER) | bus.peek(DCB_DRIVER + 1) << 8);
+    uint16_t cursor = static_cast<uint16_t>(bus.peek(CURSOR) | bus.peek(CURSOR + 1) << 8);
+    return driver == ROM_DRIVER && bus.peek(CURSOR_ON) == 0 && !(bus.peek(PORT_FF) & 0x08) &&
+           cursor >= VRAM_START && cursor <= VRAM_END;
+}
+
+void VideoHLE::load(const Bus& bus, Screen& s) {
+    for (uint16_t i = 0; i < VRAM_SIZE; i++) s.vram[i] = bus.get_vram_byte(i);
+    s.cursor = static_cast<uint16_t>(bus.peek(CURSOR) | bus.peek(CURSOR + 1) << 8);
+}
+
+bool VideoHLE::put(Screen& s, uint8_t ch, bool& scrolled) {
+    scrolled = false;
+    int pos = s.cursor - VRAM_START;
+    if ((ch >= 0x20 && ch <= 0x5F) || (ch >= 0x80 && ch <= 0xBF)) {
+        s.vram[pos] = ch;
+        pos++;
+    } else if (ch == 0x0D) {
+        pos = (pos & ~(LINE - 1)) + LINE;
+    } else {
+        return false;
+    }
+    if (pos >= VRAM_SIZE) {
+        std::memmove(s.vram, s.vram + LINE, VRAM_SIZE - LINE);
+        std::memset(s.vram + VRAM_SIZE - LINE, 0x20, LINE);
+        pos      = VRAM_SIZE - LINE;
+        scrolled = true;
+    }
+    s.cursor = static_cast<uint16_t>(VRAM_START + pos);
+    return true;
+}
+
+// ============================================================================
+// ROM SIGNATURE
+// ============================================================================
+// 0x0033: push de / ld de,401Dh — hand the video DCB to the dispatcher.
+void VideoHLE::attach(const Bus& bus) {
+    active_ = bus.peek(0x0033) == 0xD5 && bus.peek(0x0034) == 0x11 &&
+              bus.peek(0x0035) == 0x1D && bus.peek(0x0036) == 0x40;
+    if (!active_ && mode_ != Mode::OFF)
+        std::fprintf(stderr, "[VIDHLE] $DSP at 0x0033 not recognised — left to the ROM\n");
+}
+
+// ============================================================================
+// INTERCEPT
+// ============================================================================
+bool VideoHLE::handle_intercept(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts) {
+    if (mode_ == Mode::OFF) return false;
+    if (check_.pending())
+        check_.check_return(pc, cpu.get_sp(), bus.get_global_t_states(), mode_,
+                            [&](const Call& c, bool report) { return same(c, report, bus); });
+    if (pc != ROM_DSP || !active_) return false;
+    if (mode_ == Mode::ON && check_.failed()) return false;
+
+    if (!plain_state(bus)) { check_.count_deferred(); return false; }
+    Screen s;
+    load(bus, s);
+    uint8_t old[VRAM_SIZE];
+    std::memcpy(old, s.vram, VRAM_SIZE);
+    bool scrolled;
+    if (!put(s, cpu.get_a(), scrolled)) { check_.count_deferred(); return false; }
+
+    // Let the ROM run and compare at its return.
+    uint16_t sp       = cpu.get_sp();
+    uint16_t ret_addr = static_cast<uint16_t>(bus.peek(sp) | bus.peek(sp + 1) << 8);
+    if (checking(scrolled)) {
+        check_.expect(ret_addr, sp, bus.get_global_t_states(), Call{cpu.get_a(), scrolled, s});
+        return false;
+    }
+
+    for (uint16_t i = 0; i < VRAM_SIZE; i++) {
+        if (s.vram[i] != old[i]) bus.write(static_cast<uint16_t>(VRAM_START + i), s.vram[i]);
+    }
+    bus.write(CURSOR,     static_cast<uint8_t>(s.cursor));
+    bus.write(CURSOR + 1, static_cast<uint8_t>(s.cursor >> 8));
+    check_.count_native();
+    if (scrolled) scrolls_++;
+
+    cpu.set_sp(sp + 2);
+    cpu.set_pc(ret_addr);
+    int t = T_CHAR + (scrolled ? T_SCROLL : 0);
+    bus.add_ticks(t);
+    frame_ts += static_cast<uint64_t>(t);
+    return true;
+}
+
+// At the ROM's return: all of VRAM and the cursor.
+bool VideoHLE::same(const Call& c, bool report, const Bus& bus) {
+    if (c.scrolled) checked_scrolls_++;
+    Screen rom;
+    load(bus, rom);
+    int diff = -1;
+    for (int i = 0; i < VRAM_SIZE && diff < 0; i++)
+        if (rom.vram[i] != c.native.vram[i]) diff = i;
+    if (diff < 0 && rom.cursor == c.native.cursor) return true;
+    if (report) {
+        std::fprintf(stderr, "[VIDHLE] mismatch on 0x%02X: ROM cursor %04X, native %04X",
+                     c.ch, rom.cursor, c.native.cursor);
+        if (diff >= 0)
+            std::fprintf(stderr, "; VRAM %04X ROM %02X native %02X",
+                         VRAM_START + diff, rom.vram[diff], c.native.vram[diff]);
+        std::fprintf(stderr, "\n");
+    }
+    return false;
+}
+
+void VideoHLE::print_stats() const {
+    check_.print_stats(mode_);
+    if (mode_ == Mode::ON && scrolls_)
+        std::fprintf(stderr, "[VIDHLE] %llu of the native characters scrolled\n",
+                     static_cast<unsigned long long>(scrolls_));
+}
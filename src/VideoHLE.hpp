@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include "RomCheck.hpp"
+
+class Z80;
+class Bus;
+
+// Native stand-in for the Level II ROM video driver (--video-hle).
+//
+// Every character BASIC prints goes through CALL 0x0033, which pushes the
+// registers, routes through the video DCB at 0x401D to the driver at
+// 0x0458, stores the character at the cursor and, past the bottom of the
+// screen, block-moves 960 bytes of VRAM up a line.  That is a few hundred
+// T-states per character and ~20,000 per scroll, all interpreted.
+//
+// The native path handles the bulk of PRINT/LIST output in one step:
+//
+//   0x20-0x5F, 0x80-0xBF  store at the cursor, advance it
+//   0x0D                  cursor to the start of the next line
+//   cursor past 0x3FFF    scroll lines 1-15 up, blank line 15, cursor 0x3FC0
+//
+// and only when the driver is in its plain state: DCB still vectored to the
+// ROM driver, cursor off (0x4022 = 0), 64-character mode, cursor inside
+// VRAM.  Every other code (cursor movement, erase, lowercase, space
+// compression) and every other state is left to the ROM.
+//
+// The entry is used only if the ROM bytes at 0x0033 match.  VERIFY and ON
+// compare VRAM and the cursor at the return from 0x0033 (RomCheck.hpp); ON
+// trusts plain characters after PROVE_CHARS agreeing calls and scrolls
+// after PROVE_SCROLLS of them.
+class VideoHLE {
+public:
+    using Mode = HleMode;
+
+    static constexpr uint16_t ROM_DSP    = 0x0033;   // display A, DE preserved
+    static constexpr uint16_t DCB_DRIVER = 0x401E;   // video DCB driver vector
+    static constexpr uint16_t ROM_DRIVER = 0x0458;
+    static constexpr uint16_t CURSOR     = 0x4020;   // cursor address (2 bytes)
+    static constexpr uint16_t CURSOR_ON  = 0x4022;   // 0 = cursor off
+    static constexpr uint16_t PORT_FF    = 0x403D;   // copy of port FF (bit 3 = 32 col)
+
+    static constexpr int T_CHAR   = 120;    // charged per native character
+    static constexpr int T_SCROLL = 2000;   // extra per native scroll
+
+    static constexpr uint64_t PROVE_CHARS   = 100;   // ON: ROM-checked first
+    static constexpr uint64_t PROVE_SCROLLS = 2;
+
+    void set_mode(Mode m) { mode_ = m; }
+    Mode mode() const { return mode_; }
+
+    // Check the ROM signature.  Call after the ROM is loaded.
+    void attach(const Bus& bus);
+
+    // Call every step before cpu.step().  ON: if pc is 0x0033 and the
+    // character and driver state are handled natively, updates VRAM and the
+    // cursor, fakes the RET, charges T-states to bus and frame_ts and
+    // returns true (caller must skip cpu.step()).  VERIFY, and ON while the
+    // case is not yet proven: tracks calls, returns false.
+    bool handle_intercept(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts);
+
+    // True if pc is a recognised $DSP entry, whatever the mode.
+    bool is_entry(uint16_t pc) const { return pc == ROM_DSP && active_; }
+
+    void print_stats() const;
+
+private:
+    // Driver state the native path reads and writes.
+    struct Screen {
+        uint8_t  vram[1024];
+        uint16_t cursor;
+    };
+    // A ROM call being compared: the character and the native result.
+    struct Call {
+        uint8_t ch;
+        bool    scrolled;
+        Screen  native;
+    };
+
+    Mode mode_   = Mode::OFF;
+    bool active_ = false;
+    RomCheck<Call> check_{"[VIDHLE]", "$DSP"};
+
+    uint64_t scrolls_         = 0;   // native calls that scrolled
+    uint64_t checked_scrolls_ = 0;   // ROM calls compared that scrolled
+
+    static bool plain_state(const Bus& bus);
+    static void load(const Bus& bus, Screen& s);
+    // Apply `ch` to `s`.  Returns false if `ch` is not handled natively;
+    // sets `scrolled` when the screen moved up.
+    static bool put(Screen& s, uint8_t ch, bool& scrolled);
+    bool checking(bool scrolled) const {
+        return scrolled ? mode_ == Mode::VERIFY || checked_scrolls_ < PROVE_SCROLLS
+                        : check_.checking(mode_, PROVE_CHARS);
+    }
+    bool same(const Call& c, bool report, const Bus& bus);
+};
@@ -0,0 +1,104 @@
+// src/cpu/Coverage.cpp
+// Coverage files — see Coverage.hpp.
+//
+// Format (little-endian): "MAL80COV", uint32 version, uint32 runs, then the
+// executed, branch, taken and not_taken maps, 8KB each.
+#include "Coverage.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace {
+constexpr char     MAGIC[8] = {'M', 'A', 'L', '8', '0', 'C', 'O', 'V'};
+constexpr uint32_t VERSION  = 1;
+
+bool read_all(int fd, void* p, size_t n) {
+    auto* b = static_cast<uint8_t*>(p);
+    while (n) {
+        ssize_t r = ::read(fd, b, n);
+        if (r <= 0) return false;
+        b += r; n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+bool write_all(int fd, const void* p, size_t n) {
+    auto* b = static_cast<const uint8_t*>(p);
+    while (n) {
+        ssize_t r = ::write(fd, b, n);
+        if (r <= 0) return false;
+        b += r; n -= static_cast<size_t>(r);
+    }
+    return true;
+}
+}  // namespace
+
+void Coverage::merge(const Coverage& o) {
+    for (size_t i = 0; i < executed.size(); i++) {
+        executed[i]  |= o.executed[i];
+        branch[i]    |= o.branch[i];
+        taken[i]     |= o.taken[i];
+        not_taken[i] |= o.not_taken[i];
+    }
+    runs += o.runs;
+}
+
+bool Coverage::read(int fd) {
+    char     magic[8];
+    uint32_t hdr[2];
+    Coverage c;
+    if (!read_all(fd, magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(magic)) != 0 ||
+        !read_all(fd, hdr, sizeof(hdr)) || hdr[0] != VERSION ||
+        !read_all(fd, c.executed.data(),  sizeof(Bits)) ||
+        !read_all(fd, c.branch.data(),    sizeof(Bits)) ||
+        !read_all(fd, c.taken.data(),     sizeof(Bits)) ||
+        !read_all(fd, c.not_taken.data(), sizeof(Bits)))
+        return false;
+    c.runs = hdr[1];
+    *this = c;
+    return true;
+}
+
+bool Coverage::write(int fd) const {
+    uint32_t hdr[2] = {VERSION, runs};
+    return write_all(fd, MAGIC, sizeof(MAGIC)) && write_all(fd, hdr, sizeof(hdr)) &&
+           write_all(fd, executed.data(),  sizeof(Bits)) &&
+           write_all(fd, branch.data(),    sizeof(Bits)) &&
+           write_all(fd, taken.data(),     sizeof(Bits)) &&
+           write_all(fd, not_taken.data(), sizeof(Bits));
+}
+
+bool Coverage::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = read(fd);
+    ::close(fd);
+    return ok;
+}
+
+bool Coverage::save(const std::string& path) const {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = write(fd);
+    return ::close(fd) == 0 && ok;
+}
+
+bool Coverage::merge_into(const std::string& path) const {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    if (::flock(fd, LOCK_EX) != 0) { ::close(fd); return false; }
+
+    // An empty file is new; anything else must be a coverage file, or it is
+    // left alone rather than overwritten.
+    Coverage total;
+    bool ok = ::lseek(fd, 0, SEEK_END) == 0 ||
+              (::lseek(fd, 0, SEEK_SET) == 0 && total.read(fd));
+    if (ok) {
+        total.merge(*this);
+        total.runs++;
+        ok = ::lseek(fd, 0, SEEK_SET) == 0 && total.write(fd);
+    }
+    ::flock(fd, LOCK_UN);
+    return ::close(fd) == 0 && ok;
+}
@@ -0,0 +1,88 @@
+// src/cpu/Coverage.hpp
+// Z80 code coverage (--coverage <file>, tools/coverage).
+//
+// Four 64K-bit maps, one bit per address:
+//   executed   — an instruction started here (the prefix byte, for DD/ED/...)
+//   branch     — a conditional branch started here: JR cc, DJNZ, JP cc,
+//                CALL cc, RET cc, or a repeating block op (LDIR ... OTDR)
+//   taken      — ... and at least once it jumped / repeated
+//   not_taken  — ... and at least once it fell through
+//
+// Z80::step() calls record() after each instruction when a Coverage is
+// attached.  The outcome is read from where PC went, not from the handler,
+// so the translated ROM path (RomXlat) is covered the same as the
+// interpreter: a branch was taken when PC is not at the next instruction.
+// Cost is a table lookup and a few bit sets per instruction.
+//
+// Bits only ever get set, so runs merge by OR: merge_into() folds a run into
+// a file under an exclusive lock and parallel runs can share one file.
+// Addresses a host intercept stands in for (HLE routines, $KEY injection,
+// loader traps) never reach step() and show as not executed.
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+class Coverage {
+public:
+    using Bits = std::array<uint64_t, 1024>;
+
+    Bits     executed{};
+    Bits     branch{};
+    Bits     taken{};
+    Bits     not_taken{};
+    uint32_t runs = 0;      // runs merged in (a live run counts as 0)
+
+    // After one Z80::step().  `prefix` is the page pending before the step
+    // (0 for an instruction start), `op` the byte at `pc` before it ran.
+    void record(uint16_t pc, uint8_t prefix, uint8_t op, uint16_t next) {
+        if (prefix == 0x00) {
+            set(executed, pc);
+            if (int len = BRANCH_LEN[op]) outcome(pc, next != static_cast<uint16_t>(pc + len));
+        } else if (prefix == 0xED && (op & 0xF4) == 0xB0) {
+            // LDIR/CPIR/INIR/OTIR and the decrementing forms repeat by
+            // leaving PC on their ED prefix.
+            outcome(static_cast<uint16_t>(pc - 1), next != static_cast<uint16_t>(pc + 1));
+        }
+    }
+
+    static bool test(const Bits& b, uint16_t addr) { return b[addr >> 6] >> (addr & 63) & 1; }
+    // Test first: in a loop the bit is almost always set already, and a
+    // read is cheaper than a read-modify-write to the same word every step.
+    static void set(Bits& b, uint16_t addr) {
+        uint64_t& w = b[addr >> 6];
+        uint64_t bit = 1ull << (addr & 63);
+        if (!(w & bit)) w |= bit;
+    }
+
+    void clear() { *this = Coverage{}; }
+    void merge(const Coverage& o);
+
+    // File I/O.  load() fails on a missing or foreign file.
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+    // OR this run into `path` (created if missing) and count it, holding an
+    // exclusive lock for the read-modify-write.
+    bool merge_into(const std::string& path) const;
+
+private:
+    // Length of each unprefixed conditional branch, 0 for everything else.
+    static constexpr std::array<uint8_t, 256> BRANCH_LEN = [] {
+        std::array<uint8_t, 256> t{};
+        for (int op : {0x10, 0x20, 0x28, 0x30, 0x38}) t[op] = 2;          // DJNZ, JR cc
+        for (int cc = 0; cc < 8; cc++) {
+            t[0xC0 | cc << 3] = 1;                                        // RET cc
+            t[0xC2 | cc << 3] = 3;                                        // JP cc
+            t[0xC4 | cc << 3] = 3;                                        // CALL cc
+        }
+        return t;
+    }();
+
+    void outcome(uint16_t pc, bool jumped) {
+        set(branch, pc);
+        set(jumped ? taken : not_taken, pc);
+    }
+
+    bool read(int fd);
+    bool write(int fd) const;
+};
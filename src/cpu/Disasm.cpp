@@ -0,0 +1,295 @@
+// src/cpu/Disasm.cpp
+// Z80 disassembler — see Disasm.hpp.
+//
+// Opcodes are split into the usual x/y/z fields (x = bits 7-6, y = 5-3,
+// z = 2-0; p = y >> 1, q = y & 1) and looked up in the operand tables below.
+// DD/FD select IX/IY: HL becomes the index register, H/L its halves and
+// (HL) an indexed operand with a displacement byte — except where the
+// instruction already uses (HL), which keeps plain H and L.
+#include "Disasm.hpp"
+#include "../system/Bus.hpp"
+#include <cstring>
+#include <initializer_list>
+
+// ============================================================================
+// OPERAND TABLES
+// ============================================================================
+static const char* const R[8]   = {"B", "C", "D", "E", "H", "L", "(HL)", "A"};
+static const char* const RP[4]  = {"BC", "DE", "HL", "SP"};
+static const char* const RP2[4] = {"BC", "DE", "HL", "AF"};
+static const char* const CC[8]  = {"NZ", "Z", "NC", "C", "PO", "PE", "P", "M"};
+static const char* const ALU[8] = {"ADD A,", "ADC A,", "SUB ", "SBC A,",
+                                   "AND ", "XOR ", "OR ", "CP "};
+static const char* const ROT[8] = {"RLC", "RRC", "RL", "RR", "SLA", "SRA", "SLL", "SRL"};
+static const char* const X0Z7[8] = {"RLCA", "RRCA", "RLA", "RRA", "DAA", "CPL", "SCF", "CCF"};
+static const char* const IM[8]  = {"0", "0", "1", "2", "0", "0", "1", "2"};
+static const char* const BLOCK[4][4] = {
+    {"LDI",  "CPI",  "INI",  "OUTI"},
+    {"LDD",  "CPD",  "IND",  "OUTD"},
+    {"LDIR", "CPIR", "INIR", "OTIR"},
+    {"LDDR", "CPDR", "INDR", "OTDR"},
+};
+static const char* const IDX[3]  = {"HL", "IX", "IY"};
+static const char* const IDXH[3] = {"H", "IXH", "IYH"};
+static const char* const IDXL[3] = {"L", "IXL", "IYL"};
+
+static const char HEX[] = "0123456789ABCDEF";
+
+// ============================================================================
+// DECODER STATE
+// ============================================================================
+namespace {
+struct Decoder {
+    const uint8_t* bytes = nullptr;
+    uint16_t pc = 0;
+    int      pos = 0;        // bytes consumed
+    int      idx = 0;        // 0 = HL, 1 = IX, 2 = IY
+    int      disp = 0;       // displacement, once read
+    bool     have_disp = false;
+    char*    out = nullptr;
+    size_t   cap = 0;
+    size_t   len = 0;
+
+    uint8_t  next() { return bytes[pos++]; }
+
+    void put(const char* s) {
+        while (*s && len + 1 < cap) out[len++] = *s++;
+    }
+    void put_hex(unsigned v, int digits) {
+        put("0x");
+        for (int i = digits - 1; i >= 0; i--)
+            if (len + 1 < cap) out[len++] = HEX[(v >> (i * 4)) & 0xF];
+    }
+    void imm8()  { put_hex(next(), 2); }
+    void imm16() { uint8_t lo = next(); put_hex(static_cast<unsigned>(lo | (next() << 8)), 4); }
+    void rel() {
+        int8_t e = static_cast<int8_t>(next());
+        put_hex(static_cast<uint16_t>(pc + pos + e), 4);
+    }
+
+    // (HL), or (IX+d) reading d on first use.
+    void mem() {
+        if (!idx) { put("(HL)"); return; }
+        if (!have_disp) { disp = static_cast<int8_t>(next()); have_disp = true; }
+        put("(");
+        put(IDX[idx]);
+        put(disp < 0 ? "-" : "+");
+        put_hex(static_cast<unsigned>(disp < 0 ? -disp : disp), 2);
+        put(")");
+    }
+    // 8-bit register operand; `plain` keeps H/L when (IX+d) is also used.
+    void reg(int r, bool plain = false) {
+        if (r == 6)                 mem();
+        else if (r == 4 && !plain)  put(IDXH[idx]);
+        else if (r == 5 && !plain)  put(IDXL[idx]);
+        else                        put(R[r]);
+    }
+    void rp(int p)  { put(p == 2 ? IDX[idx] : RP[p]); }
+    void rp2(int p) { put(p == 2 ? IDX[idx] : RP2[p]); }
+
+    void db(std::initializer_list<uint8_t> v) {
+        put("DB ");
+        bool first = true;
+        for (uint8_t b : v) {
+            if (!first) put(",");
+            put_hex(b, 2);
+            first = false;
+        }
+    }
+
+    void cb_page();
+    void ed_page();
+    void main_page(uint8_t op);
+    void run();
+};
+}  // namespace
+
+// ============================================================================
+// CB PAGE (rotates, BIT/RES/SET) — DDCB/FDCB read d before the opcode
+// ============================================================================
+void Decoder::cb_page() {
+    if (idx) { disp = static_cast<int8_t>(next()); have_disp = true; }
+    uint8_t op = next();
+    int x = op >> 6, y = (op >> 3) & 7, z = op & 7;
+
+    switch (x) {
+        case 0: put(ROT[y]); put(" "); break;
+        case 1: put("BIT "); break;
+        case 2: put("RES "); break;
+        case 3: put("SET "); break;
+    }
+    if (x) { char bit[3] = {static_cast<char>('0' + y), ',', '\0'}; put(bit); }
+
+    if (!idx) { reg(z); return; }
+    mem();
+    // Undocumented: indexed RES/SET/rotate also copy the result to r[z]
+    if (z != 6 && x != 1) { put(","); put(R[z]); }
+}
+
+// ============================================================================
+// ED PAGE
+// ============================================================================
+void Decoder::ed_page() {
+    uint8_t op = next();
+    int x = op >> 6, y = (op >> 3) & 7, z = op & 7, p = y >> 1, q = y & 1;
+
+    if (x == 1) {
+        switch (z) {
+            case 0:
+                if (y == 6) put("IN (C)");
+                else { put("IN "); put(R[y]); put(",(C)"); }
+                return;
+            case 1:
+                if (y == 6) put("OUT (C),0");
+                else { put("OUT (C),"); put(R[y]); }
+                return;
+            case 2: put(q ? "ADC HL," : "SBC HL,"); put(RP[p]); return;
+            case 3:
+                if (q) { put("LD "); put(RP[p]); put(",("); imm16(); put(")"); }
+                else   { put("LD ("); imm16(); put("),"); put(RP[p]); }
+                return;
+            case 4: put("NEG"); return;
+            case 5: put(y == 1 ? "RETI" : "RETN"); return;
+            case 6: put("IM "); put(IM[y]); return;
+            case 7: {
+                static const char* const MISC[8] = {"LD I,A", "LD R,A", "LD A,I", "LD A,R",
+                                                    "RRD", "RLD", nullptr, nullptr};
+                if (MISC[y]) { put(MISC[y]); return; }
+                break;
+            }
+        }
+    } else if (x == 2 && z <= 3 && y >= 4) {
+        put(BLOCK[y - 4][z]);
+        return;
+    }
+    db({0xED, op});
+}
+
+// ============================================================================
+// MAIN PAGE (unprefixed, or DD/FD-indexed)
+// ============================================================================
+void Decoder::main_page(uint8_t op) {
+    int x = op >> 6, y = (op >> 3) & 7, z = op & 7, p = y >> 1, q = y & 1;
+
+    if (x == 0) {
+        switch (z) {
+            case 0:
+                switch (y) {
+                    case 0: put("NOP"); return;
+                    case 1: put("EX AF,AF'"); return;
+                    case 2: put("DJNZ "); rel(); return;
+                    case 3: put("JR "); rel(); return;
+                    default: put("JR "); put(CC[y - 4]); put(","); rel(); return;
+                }
+            case 1:
+                if (q) { put("ADD "); put(IDX[idx]); put(","); rp(p); }
+                else   { put("LD "); rp(p); put(","); imm16(); }
+                return;
+            case 2:
+                switch (y) {
+                    case 0: put("LD (BC),A"); return;
+                    case 1: put("LD A,(BC)"); return;
+                    case 2: put("LD (DE),A"); return;
+                    case 3: put("LD A,(DE)"); return;
+                    case 4: put("LD ("); imm16(); put("),"); put(IDX[idx]); return;
+                    case 5: put("LD "); put(IDX[idx]); put(",("); imm16(); put(")"); return;
+                    case 6: put("LD ("); imm16(); put("),A"); return;
+                    case 7: put("LD A,("); imm16(); put(")"); return;
+                }
+                return;
+            case 3: put(q ? "DEC " : "INC "); rp(p); return;
+            case 4: put("INC "); reg(y); return;
+            case 5: put("DEC "); reg(y); return;
+            case 6: put("LD "); reg(y); put(","); imm8(); return;
+            case 7: put(X0Z7[y]); return;
+        }
+    }
+
+    if (x == 1) {
+        if (y == 6 && z == 6) { put("HALT"); return; }
+        bool plain = (y == 6 || z == 6);     // LD H,(IX+d) keeps H
+        put("LD "); reg(y, plain); put(","); reg(z, plain);
+        return;
+    }
+
+    if (x == 2) { put(ALU[y]); reg(z); return; }
+
+    switch (z) {
+        case 0: put("RET "); put(CC[y]); return;
+        case 1:
+            if (!q) { put("POP "); rp2(p); return; }
+            switch (p) {
+                case 0: put("RET"); return;
+                case 1: put("EXX"); return;
+                case 2: put("JP ("); put(IDX[idx]); put(")"); return;
+                case 3: put("LD SP,"); put(IDX[idx]); return;
+            }
+            return;
+        case 2: put("JP "); put(CC[y]); put(","); imm16(); return;
+        case 3:
+            switch (y) {
+                case 0: put("JP "); imm16(); return;
+                case 1: cb_page(); return;
+                case 2: put("OUT ("); imm8(); put("),A"); return;
+                case 3: put("IN A,("); imm8(); put(")"); return;
+                case 4: put("EX (SP),"); put(IDX[idx]); return;
+                case 5: put("EX DE,HL"); return;     // never indexed
+                case 6: put("DI"); return;
+                case 7: put("EI"); return;
+            }
+            return;
+        case 4: put("CALL "); put(CC[y]); put(","); imm16(); return;
+        case 5:
+            if (!q) { put("PUSH "); rp2(p); return; }
+            if (p == 0) { put("CALL "); imm16(); return; }
+            if (p == 2) { ed_page(); return; }
+            return;   // DD/FD handled in run()
+        case 6: put(ALU[y]); imm8(); return;
+        case 7: put("RST "); put_hex(static_cast<unsigned>(y * 8), 2); return;
+    }
+}
+
+void Decoder::run() {
+    uint8_t op = next();
+    if (op == 0xDD || op == 0xFD) {
+        // A prefix followed by another prefix acts as a lone NOP
+        uint8_t nx = bytes[pos];
+        if (nx == 0xDD || nx == 0xFD || nx == 0xED) { db({op}); return; }
+        idx = op == 0xDD ? 1 : 2;
+        op  = next();
+    }
+    main_page(op);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+int Disasm::decode(const uint8_t* bytes, uint16_t pc, char* out, size_t out_size) {
+    Decoder d;
+    d.bytes = bytes;
+    d.pc  = pc;
+    d.out = out;
+    d.cap = out_size;
+    d.run();
+    if (out_size) out[d.len] = '\0';
+    return d.pos;
+}
+
+const char* Disasm::at(const Bus& bus, uint16_t addr, int& len) {
+    if (cache_.empty()) cache_.resize(0x10000);
+    Entry& e = cache_[addr];
+
+    uint8_t cur[MAX_LEN];
+    for (int i = 0; i < MAX_LEN; i++) cur[i] = bus.peek(static_cast<uint16_t>(addr + i));
+
+    if (e.len && std::memcmp(e.bytes, cur, e.len) == 0) {
+        hits_++;
+        len = e.len;
+        return e.text;
+    }
+    misses_++;
+    e.len = static_cast<uint8_t>(decode(cur, addr, e.text, TEXT_LEN));
+    std::memcpy(e.bytes, cur, MAX_LEN);
+    len = e.len;
+    return e.text;
+}
@@ -0,0 +1,44 @@
+// src/cpu/Disasm.hpp
+// Table-driven Z80 disassembler with a per-address decode cache.
+//
+// decode() turns up to four instruction bytes into Zilog mnemonics in the
+// style the tools/ scripts use ("LD A,(IX+0x05)", "JR NZ,0x4A12").  All
+// opcode pages are covered, including the undocumented IXH/IXL forms,
+// SLL and the DDCB/FDCB register-copy variants.
+//
+// at() decodes through Bus::peek and keeps the result per address.  An entry
+// remembers the bytes it was decoded from and is only reused while memory
+// still holds them, so writes (self-modifying code, overlays loaded over
+// old ones) invalidate it without a hook in the Bus::write() hot path.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Bus;
+
+class Disasm {
+public:
+    static constexpr int MAX_LEN  = 4;    // longest Z80 instruction (DD CB d op)
+    static constexpr int TEXT_LEN = 24;   // longest mnemonic + NUL
+
+    // Decode the instruction at `pc` whose bytes start at `bytes` (MAX_LEN
+    // readable).  Writes the mnemonic to `out` and returns the length in bytes.
+    static int decode(const uint8_t* bytes, uint16_t pc, char* out, size_t out_size);
+
+    // Cached decode of the instruction at `addr` in bus memory.  The text
+    // stays valid until the next at() for the same address.
+    const char* at(const Bus& bus, uint16_t addr, int& len);
+
+    uint64_t hits()   const { return hits_; }
+    uint64_t misses() const { return misses_; }
+
+private:
+    struct Entry {
+        uint8_t bytes[MAX_LEN] = {};
+        uint8_t len = 0;                  // 0 = never decoded
+        char    text[TEXT_LEN] = {};
+    };
+    std::vector<Entry> cache_;            // 64K entries, allocated on first use
+    uint64_t hits_ = 0, misses_ = 0;
+};
@@ -0,0 +1,24 @@
+// src/cpu/RomXlat.cpp
+// Runtime side of the translated ROM — see RomXlat.hpp.
+#include "RomXlat.hpp"
+#include "../system/Bus.hpp"
+#include "../system/Fnv1a.hpp"
+#include <cstdio>
+
+uint64_t RomXlat::hash(const uint8_t* data, size_t n) { return fnv1a(data, n); }
+
+bool RomXlat::attach(Z80& cpu, const Bus& bus) {
+    cpu.set_rom_xlat(nullptr);
+    if (!ROM_XLAT.table) {
+        std::fprintf(stderr, "[XLAT] built without roms/level2.rom — ROM interpreted\n");
+        return false;
+    }
+    if (hash(bus.get_rom().data(), ROM_SIZE) != ROM_XLAT.hash) {
+        std::fprintf(stderr, "[XLAT] ROM differs from the one translated at build time"
+                             " — ROM interpreted (rebuild to translate it)\n");
+        return false;
+    }
+    cpu.set_rom_xlat(ROM_XLAT.table);
+    std::fprintf(stderr, "[XLAT] %d ROM instructions translated\n", ROM_XLAT.count);
+    return true;
+}
@@ -0,0 +1,41 @@
+// src/cpu/RomXlat.hpp
+// Ahead-of-time translated Level II ROM.
+//
+// At build time tools/romxlat turns roms/level2.rom into build/gen/RomXlat.cpp:
+// one C++ function per ROM instruction, with operands, branch targets and
+// return addresses compiled in as constants and the same flag helpers and
+// T-state tables as the interpreter.  Z80::step() calls the function for PC
+// instead of fetching and dispatching, so results, flags, R and timing are
+// identical — only the work of decoding is gone.
+//
+// The interpreter takes over whenever the translation might not match:
+//   - the loaded ROM isn't the one translated (hash checked at attach);
+//   - a write has shadowed any byte in the ROM page being executed
+//     (LDOS patches 0x0038 and friends this way — Bus::rom_unshadowed);
+//   - PC is outside the ROM, or on an address with no function
+//     (prefixed opcodes, bytes the translator never decoded).
+#pragma once
+#include "z80.hpp"
+#include <cstddef>
+#include <cstdint>
+
+class Bus;
+
+struct RomXlatImage {
+    uint64_t           hash;    // FNV-1a of the 12KB image translated (0: none)
+    const Z80::XlatFn* table;   // ROM_SIZE entries, nullptr = interpret
+    int                count;   // functions in the table
+};
+
+// Defined in the generated build/gen/RomXlat.cpp.
+extern const RomXlatImage ROM_XLAT;
+
+class RomXlat {
+public:
+    // 64-bit FNV-1a, as computed by tools/romxlat.
+    static uint64_t hash(const uint8_t* data, size_t n);
+
+    // Hand the translated ROM to the CPU if it was built from the ROM now on
+    // the bus.  Call after the ROM is loaded.  Returns true if enabled.
+    static bool attach(Z80& cpu, const Bus& bus);
+};
@@ -0,0 +1,141 @@
+// src/cpu/Timing.hpp
+// Z80 instruction timing: T-states per opcode for each prefix page.
+//
+// Every figure is the documented total for the whole instruction, prefix
+// bytes included (Zilog UM0080 / Sean Young "The Undocumented Z80").
+// Conditional instructions are listed at their not-taken cost; the TAKEN
+// tables hold what a taken branch or a repeating block instruction adds:
+//
+//   DJNZ / JR cc      8 / 7  → +5
+//   RET cc            5      → +6
+//   CALL cc           10     → +7
+//   LDIR/CPIR/INIR/OTIR (and the D forms)  16 → +5 per repeat
+//
+// Memory wait states (video contention) are not in these tables; Bus adds
+// them as they happen and Z80::step() returns the sum.
+#pragma once
+#include <array>
+#include <cstdint>
+
+using TimingTable = std::array<uint8_t, 256>;
+
+// Cost of a DD/ED/FD/CB prefix fetch (one M1 cycle).  The interpreter runs
+// a prefix as its own step, so the step that follows charges table - this.
+constexpr int T_PREFIX = 4;
+
+// ============================================================================
+// UNPREFIXED
+// ============================================================================
+constexpr TimingTable T_MAIN = {
+//   0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F
+     4, 10,  7,  6,  4,  4,  7,  4,  4, 11,  7,  6,  4,  4,  7,  4,   // 0x00
+     8, 10,  7,  6,  4,  4,  7,  4, 12, 11,  7,  6,  4,  4,  7,  4,   // 0x10
+     7, 10, 16,  6,  4,  4,  7,  4,  7, 11, 16,  6,  4,  4,  7,  4,   // 0x20
+     7, 10, 13,  6, 11, 11, 10,  4,  7, 11, 13,  6,  4,  4,  7,  4,   // 0x30
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x40
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x50
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x60
+     7,  7,  7,  7,  7,  7,  4,  7,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x70
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x80
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0x90
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0xA0
+     4,  4,  4,  4,  4,  4,  7,  4,  4,  4,  4,  4,  4,  4,  7,  4,   // 0xB0
+     5, 10, 10, 10, 10, 11,  7, 11,  5, 10, 10,  4, 10, 17,  7, 11,   // 0xC0
+     5, 10, 10, 11, 10, 11,  7, 11,  5,  4, 10, 11, 10,  4,  7, 11,   // 0xD0
+     5, 10, 10, 19, 10, 11,  7, 11,  5,  4, 10,  4, 10,  4,  7, 11,   // 0xE0
+     5, 10, 10,  4, 10, 11,  7, 11,  5,  6, 10,  4, 10,  4,  7, 11,   // 0xF0
+};
+
+constexpr TimingTable T_TAKEN_MAIN = [] {
+    TimingTable t{};
+    t[0x10] = 5;                                           // DJNZ
+    for (int op : {0x20, 0x28, 0x30, 0x38}) t[op] = 5;     // JR cc
+    for (int cc = 0; cc < 8; cc++) {
+        t[0xC0 | cc << 3] = 6;                             // RET cc
+        t[0xC4 | cc << 3] = 7;                             // CALL cc
+    }
+    return t;
+}();
+
+// IM 1 interrupt acknowledge: two wait states in the acknowledge M1 cycle,
+// then the RST 38h push and jump.
+constexpr int T_IM1_ACK = 2 + T_MAIN[0xFF];
+
+// ============================================================================
+// CB — rotates/shifts, BIT, RES, SET
+// ============================================================================
+constexpr TimingTable T_CB = [] {
+    TimingTable t{};
+    for (int op = 0; op < 256; op++) {
+        bool bit = (op & 0xC0) == 0x40;
+        t[op] = (op & 7) != 6 ? 8 : bit ? 12 : 15;
+    }
+    return t;
+}();
+
+// ============================================================================
+// ED — extended
+// ============================================================================
+constexpr TimingTable T_ED = [] {
+    TimingTable t{};
+    t.fill(8);                                             // undefined: 8T NOP
+    for (int y = 0; y < 8; y++) {
+        int b = 0x40 | y << 3;
+        t[b + 0] = 12;                                     // IN r,(C)
+        t[b + 1] = 12;                                     // OUT (C),r
+        t[b + 2] = 15;                                     // SBC/ADC HL,rr
+        t[b + 3] = 20;                                     // LD (nn),rr / LD rr,(nn)
+        t[b + 4] = 8;                                      // NEG
+        t[b + 5] = 14;                                     // RETN / RETI
+        t[b + 6] = 8;                                      // IM n
+    }
+    t[0x47] = t[0x4F] = t[0x57] = t[0x5F] = 9;             // LD I,A / R,A / A,I / A,R
+    t[0x67] = t[0x6F] = 18;                                // RRD / RLD
+    for (int op : {0xA0, 0xA1, 0xA2, 0xA3, 0xA8, 0xA9, 0xAA, 0xAB,
+                   0xB0, 0xB1, 0xB2, 0xB3, 0xB8, 0xB9, 0xBA, 0xBB})
+        t[op] = 16;                                        // block transfer/search/IO
+    return t;
+}();
+
+constexpr TimingTable T_TAKEN_ED = [] {
+    TimingTable t{};
+    for (int op : {0xB0, 0xB1, 0xB2, 0xB3, 0xB8, 0xB9, 0xBA, 0xBB}) t[op] = 5;
+    return t;
+}();
+
+// ============================================================================
+// DD / FD — IX / IY (same timing for both)
+// ============================================================================
+// Opcodes that don't touch HL run as the unprefixed instruction plus the
+// prefix fetch; (HL) becomes (IX+d) and costs the displacement fetch and
+// address add on top.
+constexpr TimingTable T_XY = [] {
+    TimingTable t{};
+    for (int op = 0; op < 256; op++) t[op] = static_cast<uint8_t>(T_PREFIX + T_MAIN[op]);
+    for (int op : {0x09, 0x19, 0x29, 0x39}) t[op] = 15;    // ADD IX,rr
+    t[0x21] = 14;                                          // LD IX,nn
+    t[0x22] = t[0x2A] = 20;                                // LD (nn),IX / LD IX,(nn)
+    t[0x23] = t[0x2B] = 10;                                // INC/DEC IX
+    t[0x34] = t[0x35] = 23;                                // INC/DEC (IX+d)
+    t[0x36] = 19;                                          // LD (IX+d),n
+    for (int r = 0; r < 8; r++) {
+        if (r == 6) continue;
+        t[0x46 | r << 3] = 19;                             // LD r,(IX+d)
+        t[0x70 | r]      = 19;                             // LD (IX+d),r
+    }
+    for (int alu = 0; alu < 8; alu++) t[0x86 | alu << 3] = 19;   // ALU A,(IX+d)
+    t[0xE1] = 14;                                          // POP IX
+    t[0xE3] = 23;                                          // EX (SP),IX
+    t[0xE5] = 15;                                          // PUSH IX
+    t[0xE9] = 8;                                           // JP (IX)
+    t[0xF9] = 10;                                          // LD SP,IX
+    t[0xCB] = T_PREFIX;                                    // DDCB: see T_XYCB
+    return t;
+}();
+
+// DD CB d op / FD CB d op — indexed rotate, BIT, RES, SET.
+constexpr TimingTable T_XYCB = [] {
+    TimingTable t{};
+    for (int op = 0; op < 256; op++) t[op] = (op & 0xC0) == 0x40 ? 20 : 23;
+    return t;
+}();
@@ -17,6 +17,7 @@ constexpr uint8_t FLAG_S  = 0x80;  // Sign
 
 // Forward declaration
 class Bus;
+class Coverage;
 
 class Z80 {
 public:
@@ -41,6 +42,7 @@ public:
     uint16_t get_ix() const { return reg.ix; }
     uint16_t get_iy() const { return reg.iy; }
     uint8_t  get_i()  const { return reg.i;  }
+    uint8_t  get_r()  const { return reg.r;  }
     bool     get_iff1()    const { return reg.iff1;   }
     bool     get_iff2()    const { return reg.iff2;   }
     uint8_t  get_im()      const { return reg.im;     }
@@ -51,11 +53,27 @@ public:
     void set_pc(uint16_t val)     { reg.pc     = val; }
     void set_sp(uint16_t val)     { reg.sp     = val; }
     void set_a(uint8_t val)       { reg.a      = val; }
+    void set_f(uint8_t val)       { reg.f      = val; }
+    void set_bc(uint16_t val)     { reg.bc     = val; }
+    void set_de(uint16_t val)     { reg.de     = val; }
+    void set_r(uint8_t val)       { reg.r      = val; }
     void set_h(uint8_t val)       { reg.h      = val; }
     void set_l(uint8_t val)       { reg.l      = val; }
     void set_iff1(bool val)       { reg.iff1   = val; }
     void set_iff2(bool val)       { reg.iff2   = val; }
     void set_halted(bool val)     { reg.halted = val; }
+    void set_ei_pending(bool val) { reg.ei_pending = val; }
+
+    // Translated ROM (RomXlat.hpp): one function per ROM address, nullptr
+    // where the interpreter runs.  Each performs the whole instruction and
+    // returns its table T-states.  nullptr table = interpret everything.
+    using XlatFn = int (*)(Z80&);
+    void set_rom_xlat(const XlatFn* table) { xlat_ = table; }
+
+    // Code coverage (Coverage.hpp): record every instruction into `cov`
+    // from now on.  nullptr = off.
+    void set_coverage(Coverage* cov) { cov_ = cov; }
+    Coverage* coverage() const { return cov_; }
 
 private:
     // ------------------------------------------------------------------------
@@ -114,6 +132,18 @@ private:
     int t_states = 0;
     uint8_t prefix = 0x00;
     bool is_m1_cycle = true;
+    const XlatFn* xlat_ = nullptr;
+    Coverage* cov_ = nullptr;
+    uint8_t   op_  = 0;  // first byte fetched by the last step, for coverage
+    int execute();   // step() without coverage
+    friend struct RomXlatOps;   // generated by tools/romxlat
+
+    // Instruction timing comes from the tables in Timing.hpp, charged by
+    // step() after the handler runs.  Handlers only report which variant
+    // executed: a taken branch / repeating block op, or the DDCB sub-opcode.
+    bool    cond_taken = false;
+    uint8_t xycb_op    = 0;
+    void branch_taken() { cond_taken = true; }
 
     // Opcode Tables
     using OpcodeFunc = std::function<void()>;
@@ -201,4 +231,15 @@ private:
     void init_ed_table();
     void init_dd_table();
     void init_fd_table();
+
+public:
+    // Run-ahead snapshot: everything step() depends on.  Trivially copyable;
+    // the opcode tables are built once and stay with the object.
+    struct State {
+        Registers reg;
+        uint8_t   prefix;
+        bool      is_m1_cycle;
+    };
+    State save_state() const { return {reg, prefix, is_m1_cycle}; }
+    void  load_state(const State& s) { reg = s.reg; prefix = s.prefix; is_m1_cycle = s.is_m1_cycle; }
 };
\ No newline at end of file
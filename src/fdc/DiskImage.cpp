@@ -0,0 +1,568 @@
+// src/fdc/DiskImage.cpp
+// JV1 / JV3 floppy image model — see DiskImage.hpp for format notes.
+#include "DiskImage.hpp"
+#include <algorithm>
+#include <iostream>
+
+// ============================================================================
+// JV3 LAYOUT
+// ============================================================================
+static constexpr int     JV3_ENTRIES    = 2901;
+static constexpr size_t  JV3_HEADER     = JV3_ENTRIES * 3 + 1;   // + write-protect byte
+static constexpr uint8_t JV3_FREE       = 0xFF;
+static constexpr int     JV3_MAX_TRACKS = 96;
+
+static constexpr uint8_t JV3_DENSITY = 0x80;   // double density
+static constexpr uint8_t JV3_DAM     = 0x60;   // data address mark code
+static constexpr uint8_t JV3_SIDE    = 0x10;   // side 1
+static constexpr uint8_t JV3_ERROR   = 0x08;   // CRC error recorded
+static constexpr uint8_t JV3_SIZE    = 0x03;   // size code, see jv3_size()
+
+// ============================================================================
+// IMD LAYOUT
+// ============================================================================
+static constexpr uint8_t IMD_HEADER_END = 0x1A;    // ends the text header
+static constexpr uint8_t IMD_CYL_MAP    = 0x80;    // head byte: cylinder map follows
+static constexpr uint8_t IMD_HEAD_MAP   = 0x40;    // head byte: head map follows
+static constexpr uint8_t IMD_SIZE_TABLE = 0xFF;    // size code: per-sector sizes follow
+static constexpr uint8_t IMD_FM_250     = 2;       // mode: 250 kbps FM (Model I SD)
+static constexpr uint8_t IMD_MFM_250    = 5;       // mode: 250 kbps MFM
+// Sector data record types are 1 + (compressed | deleted << 1 | error << 2);
+// type 0 means the ID was found but no data could be read.
+static constexpr uint8_t IMD_COMPRESSED = 0x01;
+static constexpr uint8_t IMD_DELETED    = 0x02;
+static constexpr uint8_t IMD_ERROR      = 0x04;
+
+// Physical order of JV1 sectors around the track (1:2 interleave).
+static constexpr uint8_t JV1_INTERLEAVE[DiskImage::JV1_SECTORS] = {0,5,1,6,2,7,3,8,4,9};
+
+// Size codes differ for used and free entries:
+//   used  0=256 1=128 2=1024 3=512      free  0=512 1=1024 2=128 3=256
+static int jv3_size(uint8_t flags, bool used) {
+    int code = flags & JV3_SIZE;
+    return 128 << (code ^ (used ? 1 : 2));
+}
+
+static uint8_t jv3_size_code(size_t len, bool used) {
+    int code = 0;
+    while ((128u << code) < len && code < 3) code++;
+    return static_cast<uint8_t>(code ^ (used ? 1 : 2));
+}
+
+// SD: FB=0 FA=1 F9=2 F8=3.  DD: FB=0 F8=1.
+static uint8_t jv3_dam_to_mark(uint8_t flags) {
+    int code = (flags & JV3_DAM) >> 5;
+    if (flags & JV3_DENSITY) return code ? 0xF8 : 0xFB;
+    return static_cast<uint8_t>(0xFB - code);
+}
+
+static uint8_t jv3_mark_to_dam(uint8_t dam, bool dd) {
+    if (dd) return (dam == 0xF8) ? 0x20 : 0x00;
+    return static_cast<uint8_t>(((0xFB - dam) & 0x03) << 5);
+}
+
+// ============================================================================
+// LOAD / SAVE
+// ============================================================================
+void DiskImage::clear() {
+    format_ = Format::JV1;
+    tracks_ = 0;
+    base_.reset();
+    host_.reset();
+    jv1_dirty_.clear();
+    jv1_size_ = 0;
+    sectors_.clear();
+    jv3_write_protect_ = 0xFF;
+    imd_header_.clear();
+    imd_modes_.clear();
+}
+
+bool DiskImage::load(ImageCache::Bytes bytes) {
+    clear();
+    if (!bytes) return false;
+    base_ = std::move(bytes);
+    if (base_->size() >= 4 && std::equal(base_->begin(), base_->begin() + 4, "IMD ")) {
+        if (load_imd(*base_)) return true;
+        clear();
+        return false;
+    }
+    if (load_jv3(*base_)) return true;
+
+    format_   = Format::JV1;
+    jv1_size_ = base_->size();
+    tracks_   = static_cast<int>(jv1_size_ / (JV1_SECTORS * JV1_SECTOR_BYTES));
+    return true;
+}
+
+bool DiskImage::load_host_dir(const std::string& dir) {
+    clear();
+    auto host = std::make_shared<HostDirDisk>();
+    if (!host->mount(dir)) return false;
+    host_   = std::move(host);
+    format_ = Format::HOST;
+    tracks_ = HostDirDisk::TRACKS;
+    return true;
+}
+
+// Accept the file as JV3 only if its header is self-consistent: every used
+// entry names a plausible track, and the data implied by the header ends
+// exactly at end-of-file (or within it, for sizes JV1 can't have).
+bool DiskImage::load_jv3(const std::vector<uint8_t>& bytes) {
+    if (bytes.size() < JV3_HEADER) return false;
+    uint8_t wp = bytes[JV3_HEADER - 1];
+    if (wp != 0x00 && wp != 0xFF) return false;
+
+    size_t offset   = JV3_HEADER;
+    size_t last_end = 0;
+    int    used     = 0;
+    for (int i = 0; i < JV3_ENTRIES; i++) {
+        uint8_t t = bytes[static_cast<size_t>(i) * 3];
+        uint8_t f = bytes[static_cast<size_t>(i) * 3 + 2];
+        bool is_used = (t != JV3_FREE);
+        size_t len = static_cast<size_t>(jv3_size(f, is_used));
+        if (is_used) {
+            if (t >= JV3_MAX_TRACKS) return false;
+            used++;
+            last_end = offset + len;
+        }
+        offset += len;
+    }
+    if (used == 0 || last_end > bytes.size()) return false;
+    bool jv1_sized = bytes.size() % (JV1_SECTORS * JV1_SECTOR_BYTES) == 0;
+    if (jv1_sized && last_end != bytes.size()) return false;
+
+    offset = JV3_HEADER;
+    for (int i = 0; i < JV3_ENTRIES; i++) {
+        const uint8_t* e = &bytes[static_cast<size_t>(i) * 3];
+        bool is_used = (e[0] != JV3_FREE);
+        int  len     = jv3_size(e[2], is_used);
+        if (is_used) {
+            SectorEntry en;
+            en.id.track          = e[0];
+            en.id.id             = e[1];
+            en.id.side           = (e[2] & JV3_SIDE) ? 1 : 0;
+            en.id.double_density = (e[2] & JV3_DENSITY) != 0;
+            en.id.crc_error      = (e[2] & JV3_ERROR) != 0;
+            en.id.dam            = jv3_dam_to_mark(e[2]);
+            en.len               = len;
+            en.base_off          = offset;
+            tracks_ = std::max(tracks_, en.id.track + 1);
+            sectors_.push_back(std::move(en));
+        }
+        offset += static_cast<size_t>(len);
+    }
+    format_            = Format::JV3;
+    jv3_write_protect_ = wp;
+    return true;
+}
+
+// Index an ImageDisk file.  Nothing is copied: normal sectors point into the
+// shared bytes and compressed ones keep just their fill byte.  Cylinder and
+// head maps are skipped — sectors are filed under the physical cylinder, as
+// JV3 does.
+bool DiskImage::load_imd(const std::vector<uint8_t>& bytes) {
+    auto eoh = std::find(bytes.begin(), bytes.end(), IMD_HEADER_END);
+    if (eoh == bytes.end()) return false;
+    size_t pos  = static_cast<size_t>(eoh - bytes.begin()) + 1;
+    auto   have = [&](size_t n) { return pos + n <= bytes.size(); };
+
+    std::vector<SectorEntry> entries;
+    std::unordered_map<int, uint8_t> modes;
+    int tracks = 0;
+    while (pos < bytes.size()) {
+        if (!have(5)) return false;
+        uint8_t mode  = bytes[pos];
+        uint8_t cyl   = bytes[pos + 1];
+        uint8_t head  = bytes[pos + 2];
+        uint8_t count = bytes[pos + 3];
+        uint8_t scode = bytes[pos + 4];
+        pos += 5;
+        if (mode > IMD_MFM_250) return false;
+        if (cyl >= JV3_MAX_TRACKS || (head & ~(IMD_CYL_MAP | IMD_HEAD_MAP | 1))) return false;
+        if (scode != IMD_SIZE_TABLE && scode > 6) return false;
+
+        if (!have(count)) return false;
+        const uint8_t* smap = &bytes[pos];
+        pos += count;
+        if (head & IMD_CYL_MAP)  { if (!have(count)) return false; pos += count; }
+        if (head & IMD_HEAD_MAP) { if (!have(count)) return false; pos += count; }
+        const uint8_t* sizes = nullptr;
+        if (scode == IMD_SIZE_TABLE) {
+            if (!have(static_cast<size_t>(count) * 2)) return false;
+            sizes = &bytes[pos];
+            pos  += static_cast<size_t>(count) * 2;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int len = sizes ? (sizes[i * 2] | (sizes[i * 2 + 1] << 8)) : (128 << scode);
+            if (len <= 0 || len > MAX_SECTOR_BYTES) {
+                std::cerr << "[DISK] IMD sector of " << len << " bytes not supported\n";
+                return false;
+            }
+            if (!have(1)) return false;
+            uint8_t type = bytes[pos++];
+            if (type > 8) return false;
+
+            SectorEntry e;
+            e.id.track          = cyl;
+            e.id.side           = head & 1;
+            e.id.id             = smap[i];
+            e.id.double_density = mode > IMD_FM_250;
+            e.len               = len;
+            if (type == 0) {
+                e.fill         = 0x00;   // no data recorded: read as a CRC error
+                e.id.crc_error = true;
+            } else {
+                uint8_t t = static_cast<uint8_t>(type - 1);
+                if (t & IMD_DELETED) e.id.dam = e.id.double_density ? 0xF8 : DAM_FA;
+                e.id.crc_error = (t & IMD_ERROR) != 0;
+                if (t & IMD_COMPRESSED) {
+                    if (!have(1)) return false;
+                    e.fill = bytes[pos++];
+                } else {
+                    if (!have(static_cast<size_t>(len))) return false;
+                    e.base_off = pos;
+                    pos += static_cast<size_t>(len);
+                }
+            }
+            entries.push_back(std::move(e));
+        }
+        modes[cyl * 2 + (head & 1)] = mode;
+        tracks = std::max(tracks, cyl + 1);
+    }
+    sectors_    = std::move(entries);
+    imd_modes_  = std::move(modes);
+    imd_header_.assign(bytes.begin(), eoh + 1);
+    format_     = Format::IMD;
+    tracks_     = tracks;
+    return true;
+}
+
+std::vector<uint8_t> DiskImage::serialise() const {
+    if (format_ == Format::IMD) return serialise_imd();
+    if (format_ == Format::HOST) {
+        // Snapshot of the synthetic disk as the guest currently sees it.
+        std::vector<uint8_t> out;
+        out.reserve(size_bytes());
+        for (int t = 0; t < tracks_; t++)
+            for (int s = 0; s < JV1_SECTORS; s++) {
+                const uint8_t* p = host_->read_sector(t, s);
+                out.insert(out.end(), p, p + JV1_SECTOR_BYTES);
+            }
+        return out;
+    }
+    if (format_ == Format::JV1) {
+        std::vector<uint8_t> out(jv1_size_, 0x00);
+        if (base_)
+            std::copy(base_->begin(),
+                      base_->begin() + static_cast<ptrdiff_t>(std::min(base_->size(), jv1_size_)),
+                      out.begin());
+        for (const auto& [index, data] : jv1_dirty_) {
+            size_t off = static_cast<size_t>(index) * JV1_SECTOR_BYTES;
+            std::copy(data.begin(), data.end(), out.begin() + static_cast<ptrdiff_t>(off));
+        }
+        return out;
+    }
+
+    std::vector<uint8_t> out(JV3_HEADER, JV3_FREE);
+    size_t n = std::min(sectors_.size(), static_cast<size_t>(JV3_ENTRIES));
+    if (n < sectors_.size())
+        std::cerr << "[DISK] JV3 image has " << sectors_.size()
+                  << " sectors; only the first " << JV3_ENTRIES << " are saved\n";
+    for (size_t i = 0; i < n; i++) {
+        const Sector& s = sectors_[i].id;
+        uint8_t f = jv3_size_code(static_cast<size_t>(sectors_[i].len), true)
+                  | jv3_mark_to_dam(s.dam, s.double_density)
+                  | (s.side ? JV3_SIDE : 0)
+                  | (s.crc_error ? JV3_ERROR : 0)
+                  | (s.double_density ? JV3_DENSITY : 0);
+        out[i * 3]     = s.track;
+        out[i * 3 + 1] = s.id;
+        out[i * 3 + 2] = f;
+    }
+    out[JV3_HEADER - 1] = jv3_write_protect_;
+    for (size_t i = 0; i < n; i++) {
+        const SectorEntry& e = sectors_[i];
+        const uint8_t* d  = entry_data(e);
+        size_t len = static_cast<size_t>(jv3_size(jv3_size_code(static_cast<size_t>(e.len), true), true));
+        out.insert(out.end(), d, d + e.len);
+        out.resize(out.size() + (len - static_cast<size_t>(e.len)), 0xE5);
+    }
+    return out;
+}
+
+// One track record per run of entries sharing track, side and density;
+// single-valued sectors are written back compressed.
+std::vector<uint8_t> DiskImage::serialise_imd() const {
+    std::vector<uint8_t> out(imd_header_.begin(), imd_header_.end());
+    if (out.empty()) {
+        static const char fresh[] = "IMD 1.18: Mal-80\r\n\x1A";
+        out.assign(fresh, fresh + sizeof(fresh) - 1);
+    }
+    size_t i = 0;
+    while (i < sectors_.size()) {
+        const Sector& first = sectors_[i].id;
+        size_t j = i;
+        bool same_len = true;
+        while (j < sectors_.size() && j - i < 255) {
+            const Sector& s = sectors_[j].id;
+            if (s.track != first.track || s.side != first.side ||
+                s.double_density != first.double_density) break;
+            same_len &= (sectors_[j].len == sectors_[i].len);
+            j++;
+        }
+        auto m = imd_modes_.find(first.track * 2 + first.side);
+        uint8_t mode = first.double_density ? IMD_MFM_250 : IMD_FM_250;
+        if (m != imd_modes_.end() && (m->second > IMD_FM_250) == first.double_density)
+            mode = m->second;
+        uint8_t scode = IMD_SIZE_TABLE;
+        for (uint8_t k = 0; same_len && k <= 3; k++)
+            if ((128 << k) == sectors_[i].len) scode = k;
+
+        out.push_back(mode);
+        out.push_back(first.track);
+        out.push_back(first.side);
+        out.push_back(static_cast<uint8_t>(j - i));
+        out.push_back(scode);
+        for (size_t k = i; k < j; k++) out.push_back(sectors_[k].id.id);
+        if (scode == IMD_SIZE_TABLE)
+            for (size_t k = i; k < j; k++) {
+                out.push_back(static_cast<uint8_t>(sectors_[k].len));
+                out.push_back(static_cast<uint8_t>(sectors_[k].len >> 8));
+            }
+        for (size_t k = i; k < j; k++) {
+            const SectorEntry& e = sectors_[k];
+            const uint8_t* d = entry_data(e);
+            bool uniform = std::all_of(d, d + e.len, [&](uint8_t b) { return b == d[0]; });
+            bool deleted = e.id.double_density ? (e.id.dam == 0xF8) : (e.id.dam != DAM_NORMAL);
+            out.push_back(static_cast<uint8_t>(1 + (uniform ? IMD_COMPRESSED : 0)
+                                                 + (deleted ? IMD_DELETED : 0)
+                                                 + (e.id.crc_error ? IMD_ERROR : 0)));
+            if (uniform) out.push_back(d[0]);
+            else         out.insert(out.end(), d, d + e.len);
+        }
+        i = j;
+    }
+    return out;
+}
+
+size_t DiskImage::size_bytes() const {
+    if (format_ == Format::JV1) return jv1_size_;
+    if (format_ == Format::HOST)
+        return static_cast<size_t>(tracks_) * JV1_SECTORS * JV1_SECTOR_BYTES;
+    if (format_ == Format::IMD) return serialise_imd().size();
+    size_t n = JV3_HEADER;
+    for (const auto& e : sectors_) n += static_cast<size_t>(e.len);
+    return n;
+}
+
+size_t DiskImage::private_bytes() const {
+    size_t n = 0;
+    for (const auto& [index, data] : jv1_dirty_) n += data.size();
+    for (const auto& e : sectors_) n += e.own.size();
+    if (host_) n += host_->overlay_bytes();
+    return n;
+}
+
+// ============================================================================
+// SECTOR ACCESS
+// ============================================================================
+const uint8_t* DiskImage::jv1_sector(uint32_t index) const {
+    static const std::vector<uint8_t> zeros(JV1_SECTOR_BYTES, 0x00);
+    size_t offset = static_cast<size_t>(index) * JV1_SECTOR_BYTES;
+    if (offset + JV1_SECTOR_BYTES > jv1_size_) return nullptr;
+    auto it = jv1_dirty_.find(index);
+    if (it != jv1_dirty_.end()) return it->second.data();
+    if (base_ && offset + JV1_SECTOR_BYTES <= base_->size()) return base_->data() + offset;
+    return zeros.data();   // inside a grown image but never written
+}
+
+const uint8_t* DiskImage::entry_data(const SectorEntry& e) const {
+    if (!e.own.empty()) return e.own.data();
+    if (e.fill < 0)     return base_->data() + e.base_off;
+    fill_buf_.assign(static_cast<size_t>(e.len), static_cast<uint8_t>(e.fill));
+    return fill_buf_.data();
+}
+
+const uint8_t* DiskImage::find_sector(int track, int sector, int& len, uint8_t& dam) const {
+    if (format_ == Format::JV1) {
+        if (track < 0 || track >= tracks_ || sector < 0 || sector >= JV1_SECTORS)
+            return nullptr;
+        const uint8_t* p = jv1_sector(static_cast<uint32_t>(track * JV1_SECTORS + sector));
+        if (!p) return nullptr;
+        len = JV1_SECTOR_BYTES;
+        dam = (track == JV1_DIR_TRACK) ? DAM_FA : DAM_NORMAL;
+        return p;
+    }
+    if (format_ == Format::HOST) {
+        const uint8_t* p = host_->read_sector(track, sector);
+        if (!p) return nullptr;
+        len = JV1_SECTOR_BYTES;
+        dam = (track == HostDirDisk::DIR_TRACK) ? DAM_FA : DAM_NORMAL;
+        return p;
+    }
+    for (const auto& e : sectors_) {
+        const Sector& s = e.id;
+        if (s.track == track && s.id == sector && s.side == 0 && !s.double_density) {
+            len = e.len;
+            dam = s.dam;
+            return entry_data(e);
+        }
+    }
+    return nullptr;
+}
+
+bool DiskImage::write_sector(int track, int sector, const uint8_t* data, int len, uint8_t dam) {
+    if (format_ == Format::JV1) {
+        // JV1 has no per-sector DAM; the directory-track convention applies.
+        uint32_t index = static_cast<uint32_t>(track * JV1_SECTORS + sector);
+        size_t   end   = (static_cast<size_t>(index) + 1) * JV1_SECTOR_BYTES;
+        if (end > jv1_size_) {
+            // Extend image if needed (e.g. formatting a larger disk)
+            jv1_size_ = end;
+            tracks_   = std::max(tracks_, track + 1);
+        }
+        auto& own = jv1_dirty_[index];
+        own.assign(data, data + std::min(len, JV1_SECTOR_BYTES));
+        own.resize(JV1_SECTOR_BYTES, 0x00);
+        return true;
+    }
+    if (format_ == Format::HOST) {
+        uint8_t full[JV1_SECTOR_BYTES] = {};
+        std::copy(data, data + std::min(len, JV1_SECTOR_BYTES), full);
+        return host_->write_sector(track, sector, full);
+    }
+    for (auto& e : sectors_) {
+        const Sector& s = e.id;
+        if (s.track == track && s.id == sector && s.side == 0 && !s.double_density) {
+            if (e.own.empty()) {
+                const uint8_t* src = entry_data(e);
+                e.own.assign(src, src + e.len);   // copy-on-write
+                e.fill = -1;
+            }
+            std::copy(data, data + std::min(len, e.len), e.own.begin());
+            e.id.dam = dam;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<DiskImage::Sector> DiskImage::track_layout(int track, bool with_data) const {
+    std::vector<Sector> out;
+    if (format_ == Format::JV1 || format_ == Format::HOST) {   // JV1 geometry
+        if (track < 0 || track >= tracks_) return out;
+        for (uint8_t id : JV1_INTERLEAVE) {
+            Sector s;
+            s.track = static_cast<uint8_t>(track);
+            s.id    = id;
+            int len; uint8_t dam;
+            const uint8_t* p = find_sector(track, id, len, dam);
+            if (!p) continue;
+            s.dam = dam;
+            if (with_data) s.data.assign(p, p + len);
+            else           s.data.resize(static_cast<size_t>(len));
+            out.push_back(std::move(s));
+        }
+        return out;
+    }
+    for (const auto& e : sectors_) {
+        const Sector& id = e.id;
+        if (id.track != track || id.side != 0 || id.double_density) continue;
+        Sector s = id;
+        if (with_data) {
+            const uint8_t* p = entry_data(e);
+            s.data.assign(p, p + e.len);
+        } else {
+            s.data.resize(static_cast<size_t>(e.len));
+        }
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+// ============================================================================
+// TRACK FORMATTING
+// ============================================================================
+// JV1 can only hold ten 256-byte sectors numbered 0-9 whose ID carries the
+// physical track number and whose DAM matches the JV1 convention.
+bool DiskImage::fits_jv1(int track, const std::vector<Sector>& secs) {
+    if (secs.size() != JV1_SECTORS) return false;
+    uint16_t seen = 0;
+    for (const auto& s : secs) {
+        if (s.track != track || s.side != 0 || s.id >= JV1_SECTORS) return false;
+        if (s.data.size() != JV1_SECTOR_BYTES || s.crc_error || s.double_density) return false;
+        bool dam_ok = (s.dam == DAM_NORMAL) || (track == JV1_DIR_TRACK && s.dam == DAM_FA);
+        if (!dam_ok) return false;
+        seen |= static_cast<uint16_t>(1u << s.id);
+    }
+    return seen == (1u << JV1_SECTORS) - 1;
+}
+
+// Sectors still unmodified keep pointing at the shared JV1 bytes (the
+// offsets are simply re-expressed as JV3 entries); written ones move over.
+void DiskImage::convert_to_jv3() {
+    std::vector<SectorEntry> all;
+    for (int t = 0; t < tracks_; t++) {
+        for (uint8_t id : JV1_INTERLEAVE) {
+            uint32_t index = static_cast<uint32_t>(t * JV1_SECTORS + id);
+            size_t   off   = static_cast<size_t>(index) * JV1_SECTOR_BYTES;
+            if (off + JV1_SECTOR_BYTES > jv1_size_) continue;
+            SectorEntry e;
+            e.id.track = static_cast<uint8_t>(t);
+            e.id.id    = id;
+            e.id.dam   = (t == JV1_DIR_TRACK) ? DAM_FA : DAM_NORMAL;
+            e.len      = JV1_SECTOR_BYTES;
+            auto it = jv1_dirty_.find(index);
+            if (it != jv1_dirty_.end()) {
+                e.own = std::move(it->second);
+            } else if (base_ && off + JV1_SECTOR_BYTES <= base_->size()) {
+                e.base_off = off;
+            } else {
+                e.own.assign(JV1_SECTOR_BYTES, 0x00);
+            }
+            all.push_back(std::move(e));
+        }
+    }
+    jv1_dirty_.clear();
+    jv1_size_ = 0;
+    sectors_      = std::move(all);
+    format_   = Format::JV3;
+    std::cout << "[DISK] Non-JV1 track layout written; image converted to JV3\n";
+}
+
+void DiskImage::format_track(int track, std::vector<Sector> secs) {
+    if (format_ == Format::HOST) {
+        std::cerr << "[DISK] Write Track on host directory " << host_->path()
+                  << " ignored (track " << track << ")\n";
+        return;
+    }
+    if (format_ == Format::JV1 && fits_jv1(track, secs)) {
+        for (const auto& s : secs)
+            write_sector(track, s.id, s.data.data(), static_cast<int>(s.data.size()), s.dam);
+        return;
+    }
+    if (format_ == Format::JV1) convert_to_jv3();
+
+    // Replace the track's side-0 SD sectors in place (keeps file order stable).
+    auto on_track = [&](const SectorEntry& e) {
+        return e.id.track == track && e.id.side == 0 && !e.id.double_density;
+    };
+    auto first = std::find_if(sectors_.begin(), sectors_.end(), on_track);
+    size_t at  = static_cast<size_t>(first - sectors_.begin());
+    sectors_.erase(std::remove_if(sectors_.begin(), sectors_.end(), on_track), sectors_.end());
+    at = std::min(at, sectors_.size());
+
+    std::vector<SectorEntry> fresh;
+    for (auto& s : secs) {
+        SectorEntry e;
+        e.len = static_cast<int>(s.data.size());
+        e.own = std::move(s.data);
+        e.id  = std::move(s);
+        e.id.data.clear();
+        fresh.push_back(std::move(e));
+    }
+    sectors_.insert(sectors_.begin() + static_cast<ptrdiff_t>(at),
+                    std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+    tracks_ = std::max(tracks_, track + 1);
+}
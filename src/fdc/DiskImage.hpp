@@ -0,0 +1,141 @@
+// src/fdc/DiskImage.hpp
+// In-memory floppy image for one drive, independent of the FD1771 logic.
+//
+// Three on-disk formats are understood:
+//
+//   JV1 — flat array of 256-byte sectors, 10 per track, track-major.  No
+//         per-sector metadata: by convention track 17 (directory) carries
+//         the FA data address mark and every other sector FB.
+//
+//   JV3 — 2901-entry sector header (track, sector, flags) + write-protect
+//         byte, followed by the sector data in header order.  Sectors may
+//         be 128/256/512/1024 bytes, in any order and numbering, with their
+//         own DAM, so copy-protected and non-standard layouts round-trip.
+//         Only the first header block is supported (≤ 2901 sectors).
+//
+//   IMD — ImageDisk: text header, then one record per track (mode, cyl,
+//         head, sector map, optional size table) with a typed data record
+//         per sector.  Sectors filled with a single byte are stored as that
+//         byte; they stay compressed in memory and are expanded only when
+//         read.  IMD cannot tell F8/F9/FA apart ("deleted"), so deleted SD
+//         sectors load as FA, the Model I directory mark.
+//
+// A JV1 image stays JV1 as long as what is written to it fits the JV1 shape;
+// the first Write Track that produces a non-standard layout converts it to
+// JV3 in memory (and save() then writes JV3).
+//
+// A third source, HOST, is a directory on the host presented as an LDOS data
+// disk (see HostDirDisk.hpp); it has JV1 geometry and serialises as JV1.
+//
+// The file bytes are shared, read-only, through ImageCache: many machines
+// mounting the same disk hold one copy.  Each DiskImage keeps only its own
+// modified sectors (a sparse copy-on-write overlay), so memory grows with
+// writes, not with the number of instances.
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "HostDirDisk.hpp"
+#include "ImageCache.hpp"
+
+class DiskImage {
+public:
+    enum class Format { JV1, JV3, IMD, HOST };
+
+    static constexpr int JV1_SECTORS      = 10;
+    static constexpr int JV1_SECTOR_BYTES = 256;
+    static constexpr int JV1_DIR_TRACK    = 17;
+    static constexpr int MAX_SECTOR_BYTES = 1024;
+
+    // Data address marks (FD1771 write-sector a1a0 / write-track F8-FB).
+    static constexpr uint8_t DAM_NORMAL  = 0xFB;
+    static constexpr uint8_t DAM_FA      = 0xFA;
+
+    // One sector's ID field and data, as it sits on the track.
+    struct Sector {
+        uint8_t track = 0, side = 0, id = 0;
+        uint8_t dam   = DAM_NORMAL;
+        bool    crc_error = false;
+        bool    double_density = false;   // JV3 DD sector: preserved, unreadable by FD1771
+        std::vector<uint8_t> data;
+    };
+
+    // Attach shared file bytes; format is detected from content.  False if
+    // the bytes claim a format (IMD header) but are malformed.
+    bool load(ImageCache::Bytes bytes);
+    // Present a host directory as a disk.  False if it cannot be read.
+    bool load_host_dir(const std::string& dir);
+    // Start an empty (unformatted) JV1 image.
+    void clear();
+    // Serialise in the current format.
+    std::vector<uint8_t> serialise() const;
+
+    Format format() const { return format_; }
+    int    tracks() const { return tracks_; }
+    size_t size_bytes() const;
+    // Bytes owned by this instance (overlay), excluding the shared base.
+    size_t private_bytes() const;
+
+    // Sector access by ID on side 0.  Returns nullptr if the ID field is not
+    // on the track.  len/dam receive the data length and address mark.
+    // The pointer is valid only until the next find_sector(), write or
+    // format on this image: a compressed IMD sector is expanded into one
+    // scratch buffer shared by all lookups.  Copy the bytes to keep them.
+    const uint8_t* find_sector(int track, int sector, int& len, uint8_t& dam) const;
+    // Overwrite an existing sector's data (len bytes) and DAM.  JV1 images
+    // grow to hold the sector.  Returns false if the ID is not on the track.
+    bool write_sector(int track, int sector, const uint8_t* data, int len, uint8_t dam);
+
+    // Sector IDs on a track, in physical (rotational) order from the index.
+    std::vector<Sector> track_layout(int track, bool with_data) const;
+
+    // Replace a whole track with the given sectors (Write Track result).
+    void format_track(int track, std::vector<Sector> secs);
+
+private:
+    Format format_ = Format::JV1;
+    int    tracks_ = 0;
+
+    ImageCache::Bytes base_;          // shared, immutable file bytes (may be null)
+    std::shared_ptr<HostDirDisk> host_;   // HOST: the directory behind the disk
+
+    // JV1: sector n lives at base_[n*256] unless overridden in jv1_dirty_.
+    // jv1_size_ is the logical image size (grows when sectors past the end
+    // of the file are written; unwritten gaps read as zeros).
+    std::unordered_map<uint32_t, std::vector<uint8_t>> jv1_dirty_;
+    size_t jv1_size_ = 0;
+
+    // JV3 / IMD: one entry per sector in file order.  Data stays in base_
+    // at base_off (or, for a compressed IMD sector, as the single fill byte)
+    // until the sector is written or the track reformatted, when the entry
+    // takes its own copy in `own`.
+    struct SectorEntry {
+        Sector  id;                   // ID fields; id.data is unused
+        int     len      = 0;
+        size_t  base_off = 0;
+        int     fill     = -1;        // IMD compressed: every byte is `fill`
+        std::vector<uint8_t> own;     // private copy (empty = use base_)
+    };
+    std::vector<SectorEntry> sectors_;
+    uint8_t jv3_write_protect_ = 0xFF;
+
+    // IMD: the original text header (through the 0x1A terminator) and the
+    // recording mode of each track record, keyed by track * 2 + side.
+    std::string imd_header_;
+    std::unordered_map<int, uint8_t> imd_modes_;
+
+    // Expanded copy of the last compressed sector handed out.
+    mutable std::vector<uint8_t> fill_buf_;
+
+    const uint8_t* jv1_sector(uint32_t index) const;
+    // The entry's bytes: in base_, in `own`, or (compressed) in fill_buf_,
+    // overwritten by the next call — see find_sector().
+    const uint8_t* entry_data(const SectorEntry& e) const;
+    bool load_jv3(const std::vector<uint8_t>& bytes);
+    bool load_imd(const std::vector<uint8_t>& bytes);
+    std::vector<uint8_t> serialise_imd() const;
+    void convert_to_jv3();
+    static bool fits_jv1(int track, const std::vector<Sector>& secs);
+};
@@ -1,7 +1,10 @@
 // src/fdc/FDC.cpp
 // FD1771 Floppy Disk Controller — see FDC.hpp for architecture notes.
 #include "FDC.hpp"
+#include "../system/ZipReader.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 
@@ -11,10 +14,142 @@
 static constexpr uint8_t ST_BUSY     = 0x01;  // Command in progress
 static constexpr uint8_t ST_DRQ      = 0x02;  // Data request (type II/III) / Index (type I)
 static constexpr uint8_t ST_TRACK0   = 0x04;  // Head on track 0 (type I)
+static constexpr uint8_t ST_LOSTDATA = 0x04;  // CPU missed a DRQ (type II/III)
 static constexpr uint8_t ST_RNF      = 0x10;  // Record not found (type II/III)
 static constexpr uint8_t ST_RECTYPE  = 0x20;  // Record type: deleted data mark (type II/III)
 static constexpr uint8_t ST_NOTREADY = 0x80;  // No disk in drive
 
+// Entries picked from a bare .zip given as a disk path.
+static const std::vector<std::string> DISK_EXTS = {".dsk", ".jv1", ".jv3", ".imd"};
+
+// ============================================================================
+// ROTATIONAL LAYOUT (ACCURATE mode)
+// ============================================================================
+// The sectors of a track (in DiskImage::track_layout() order — the 1:2 JV1
+// interleave for JV1 images) occupy equal slots after the index hole.  Each
+// slot starts with its ID field; the data field's first byte follows after
+// the ID, gap and data address mark.
+static constexpr uint64_t POST_INDEX_T = 16 * FDC::T_PER_BYTE;  // gap after index
+static constexpr uint64_t ID_TO_DATA_T = 18 * FDC::T_PER_BYTE;  // ID+CRC, gap, DAM
+static constexpr uint64_t SETTLE_T     = 10 * FDC::T_PER_MS;    // head settle / E delay
+static constexpr uint64_t RNF_T        =  4 * FDC::T_PER_REV;   // search gives up
+static constexpr int      STEP_MS[4]   = {6, 6, 10, 20};        // FD1771 r1r0 rates
+
+static int slot_of_sector(const std::vector<DiskImage::Sector>& layout, int sector) {
+    for (size_t p = 0; p < layout.size(); p++)
+        if (layout[p].id == sector) return static_cast<int>(p);
+    return 0;
+}
+
+// ============================================================================
+// RAW TRACK FORMAT (Read Track / Write Track)
+// ============================================================================
+// FM single-density marks.  On the FD1771, bytes F7-FE written during Write
+// Track are control codes: F7 emits the two CRC bytes, F8-FB a data address
+// mark, FC the index mark and FE an ID address mark.
+static constexpr uint8_t MARK_CRC   = 0xF7;
+static constexpr uint8_t MARK_INDEX = 0xFC;
+static constexpr uint8_t MARK_ID    = 0xFE;
+
+// Gap sizes for synthesised tracks (TRSDOS-style SD layout; 10 × 256-byte
+// sectors fit in the 3125-byte revolution with room to spare).
+static constexpr int GAP1 = 16;   // after index mark
+static constexpr int GAP2 = 11;   // ID CRC → data mark
+static constexpr int GAP3 = 12;   // data CRC → next ID
+static constexpr int SYNC = 6;    // 00 bytes before each mark
+
+// CRC-16/CCITT (x^16+x^12+x^5+1), preset 0xFFFF, over mark + field bytes.
+static uint16_t crc16(uint16_t crc, uint8_t b) {
+    crc ^= static_cast<uint16_t>(b << 8);
+    for (int i = 0; i < 8; i++)
+        crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+    return crc;
+}
+
+static int size_code(size_t len) {
+    int code = 0;
+    while ((128u << code) < len && code < 3) code++;
+    return code;
+}
+
+// Single-pass parser for a Write Track stream: collects each FE ID field and
+// the F8-FB data field that follows it into a sector.  Gap, sync, index and
+// CRC bytes are skipped; a data field cut off by the end of the track, or a
+// data mark with no preceding ID, is dropped.
+static std::vector<DiskImage::Sector> parse_track(const uint8_t* p, int n) {
+    enum class St { GAP, ID, DATA } st = St::GAP;
+    std::vector<DiskImage::Sector> out;
+    uint8_t id[4] = {};
+    int     idn = 0;
+    bool    have_id = false;
+    size_t  want = 0;
+    DiskImage::Sector cur;
+
+    for (int i = 0; i < n; i++) {
+        uint8_t b = p[i];
+        switch (st) {
+        case St::GAP:
+            if (b == MARK_ID) {
+                st = St::ID; idn = 0;
+            } else if (b >= 0xF8 && b <= 0xFB && have_id) {
+                cur        = DiskImage::Sector{};
+                cur.track  = id[0];
+                cur.side   = id[1] & 0x01;
+                cur.id     = id[2];
+                cur.dam    = b;
+                want       = static_cast<size_t>(128) << (id[3] & 0x03);
+                cur.data.reserve(want);
+                st = St::DATA;
+            }
+            break;
+        case St::ID:
+            id[idn++] = b;
+            if (idn == 4) { have_id = true; st = St::GAP; }
+            break;
+        case St::DATA:
+            cur.data.push_back(b);
+            if (cur.data.size() == want) {
+                out.push_back(std::move(cur));
+                have_id = false;
+                st = St::GAP;
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+// Inverse of parse_track(): lay the track's sectors out as a raw FM stream.
+static int build_track(const std::vector<DiskImage::Sector>& secs,
+                       uint8_t* out, int cap) {
+    int n = 0;
+    auto put = [&](uint8_t b) { if (n < cap) out[n++] = b; };
+    auto fill = [&](uint8_t b, int count) { for (int i = 0; i < count; i++) put(b); };
+
+    fill(0x00, SYNC);
+    put(MARK_INDEX);
+    fill(0xFF, GAP1);
+    for (const auto& s : secs) {
+        fill(0x00, SYNC);
+        uint8_t idf[5] = {MARK_ID, s.track, s.side, s.id,
+                          static_cast<uint8_t>(size_code(s.data.size()))};
+        uint16_t crc = 0xFFFF;
+        for (uint8_t b : idf) { put(b); crc = crc16(crc, b); }
+        put(static_cast<uint8_t>(crc >> 8));
+        put(static_cast<uint8_t>(crc));
+        fill(0xFF, GAP2);
+        fill(0x00, SYNC);
+        crc = crc16(0xFFFF, s.dam);
+        put(s.dam);
+        for (uint8_t b : s.data) { put(b); crc = crc16(crc, b); }
+        put(static_cast<uint8_t>(crc >> 8));
+        put(static_cast<uint8_t>(crc));
+        fill(0xFF, GAP3);
+    }
+    fill(0xFF, cap - n);   // gap 4 to the index hole
+    return n;
+}
+
 // ============================================================================
 // DISK IMAGE LOADING
 // ============================================================================
@@ -23,22 +158,38 @@ bool FDC::load_disk(int drive, const std::string& path) {
         std::cerr << "[FDC] Invalid drive index: " << drive << "\n";
         return false;
     }
-    std::ifstream f(path, std::ios::binary);
-    if (!f) {
+    std::error_code ec;
+    if (std::filesystem::is_directory(path, ec)) return load_host_dir(drive, path);
+
+    // Image bytes are shared process-wide; this drive only owns its writes.
+    // A bare .zip mounts its first disk image.
+    ImageCache::Bytes bytes = ImageCache::load_file(path, DISK_EXTS);
+    if (!bytes) {
         std::cerr << "[FDC] Cannot open disk image: " << path << "\n";
         return false;
     }
-    f.seekg(0, std::ios::end);
-    size_t size = static_cast<size_t>(f.tellg());
-    f.seekg(0, std::ios::beg);
+    return mount(drive, std::move(bytes), path);
+}
 
-    drives_[drive].image.resize(size);
-    f.read(reinterpret_cast<char*>(drives_[drive].image.data()),
-           static_cast<std::streamsize>(size));
+bool FDC::load_disk_bytes(int drive, std::vector<uint8_t> bytes, const std::string& name) {
+    if (drive < 0 || drive >= DRIVES) {
+        std::cerr << "[FDC] Invalid drive index: " << drive << "\n";
+        return false;
+    }
+    return mount(drive, ImageCache::intern(std::move(bytes)), name);
+}
+
+bool FDC::mount(int drive, ImageCache::Bytes bytes, const std::string& path) {
+    size_t size = bytes->size();
+    if (!drives_[drive].image.load(std::move(bytes))) {
+        std::cerr << "[FDC] Malformed disk image: " << path << "\n";
+        return false;
+    }
     drives_[drive].loaded     = true;
+    drives_[drive].dirty      = false;
+    drives_[drive].generation = ++generations_;
     disk_names_[drive]        = path;
     drives_[drive].head_track = 0;
-    drives_[drive].tracks     = static_cast<int>(size / (SECTORS_PER_TRACK * BYTES_PER_SECTOR));
     // FD1771 power-on state: head on track 0, motor not yet running.
     // The Level II ROM checks: LD A,(0x37EC); INC A; CP 2; JP C, no_disk
     // Status 0x00 is treated same as 0xFF (no FDC). Must be >= 0x01.
@@ -49,7 +200,74 @@ bool FDC::load_disk(int drive, const std::string& path) {
     status_ = ST_NOTREADY | ST_TRACK0;
     std::cout << "[FDC] Drive " << drive << ": loaded " << path
               << " (" << size << " bytes, "
-              << drives_[drive].tracks << " tracks)\n";
+              << (drives_[drive].image.format() == DiskImage::Format::JV3 ? "JV3, " :
+                  drives_[drive].image.format() == DiskImage::Format::IMD ? "IMD, " : "")
+              << drives_[drive].image.tracks() << " tracks)\n";
+    return true;
+}
+
+bool FDC::load_host_dir(int drive, const std::string& path) {
+    if (!drives_[drive].image.load_host_dir(path)) {
+        std::cerr << "[FDC] Cannot read host directory: " << path << "\n";
+        return false;
+    }
+    drives_[drive].loaded     = true;
+    drives_[drive].dirty      = false;
+    disk_names_[drive]        = path;
+    drives_[drive].head_track = 0;
+    status_ = ST_NOTREADY | ST_TRACK0;
+    std::cout << "[FDC] Drive " << drive << ": host directory " << path
+              << " as LDOS data disk\n";
+    return true;
+}
+
+bool FDC::new_disk(int drive, const std::string& path) {
+    if (drive < 0 || drive >= DRIVES) {
+        std::cerr << "[FDC] Invalid drive index: " << drive << "\n";
+        return false;
+    }
+    drives_[drive].image.clear();
+    drives_[drive].loaded     = true;
+    drives_[drive].dirty      = true;   // must be saved even if never formatted
+    drives_[drive].generation = ++generations_;
+    drives_[drive].head_track = 0;
+    disk_names_[drive]        = path;
+    status_ = ST_NOTREADY | ST_TRACK0;
+    std::cout << "[FDC] Drive " << drive << ": new unformatted disk " << path << "\n";
+    return true;
+}
+
+bool FDC::save_disk(int drive) {
+    if (drive < 0 || drive >= DRIVES || !drives_[drive].loaded) return false;
+    if (drives_[drive].image.format() == DiskImage::Format::HOST) {
+        drives_[drive].dirty = false;   // written through as it happened
+        return true;
+    }
+    const std::string& path = disk_names_[drive];
+    auto src = ZipReader::resolve(path, DISK_EXTS);
+    if (src && src->from_zip()) {
+        std::cerr << "[FDC] Drive " << drive << ": " << path
+                  << " is inside a zip archive; changes not saved\n";
+        return false;
+    }
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        std::cerr << "[FDC] Cannot write disk image: " << path << "\n";
+        return false;
+    }
+    auto bytes = drives_[drive].image.serialise();
+    f.write(reinterpret_cast<const char*>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+    f.close();
+    if (!f) {
+        // Disk full or I/O error: the drive stays dirty, so nothing is lost
+        // that a later save could still write.
+        std::cerr << "[FDC] Drive " << drive << ": error writing " << path << "\n";
+        return false;
+    }
+    drives_[drive].dirty = false;
+    std::cout << "[FDC] Drive " << drive << ": saved " << path
+              << " (" << bytes.size() << " bytes)\n";
     return true;
 }
 
@@ -62,6 +280,25 @@ bool FDC::is_present() const {
     return false;
 }
 
+std::vector<uint8_t> FDC::image_bytes(int drive) const {
+    if (drive < 0 || drive >= DRIVES || !drives_[drive].loaded) return {};
+    return drives_[drive].image.serialise();
+}
+
+uint64_t FDC::write_generation(int drive) const {
+    if (drive < 0 || drive >= DRIVES || !drives_[drive].loaded) return 0;
+    if (drives_[drive].image.format() == DiskImage::Format::HOST) return 0;
+    return drives_[drive].generation;
+}
+
+bool FDC::image_hash(int drive, uint64_t& out) const {
+    out = 0;
+    if (drive < 0 || drive >= DRIVES || !drives_[drive].loaded) return true;
+    if (drives_[drive].image.format() == DiskImage::Format::HOST) return false;
+    out = ImageCache::hash(drives_[drive].image.serialise());
+    return true;
+}
+
 // ============================================================================
 // DRIVE SELECTION
 // ============================================================================
@@ -81,42 +318,22 @@ FDC::Drive* FDC::active_drive() {
     return &drives_[idx];
 }
 
-// ============================================================================
-// JV1 SECTOR ACCESS
-// ============================================================================
-std::vector<uint8_t> FDC::Drive::read_sector(int track, int sector) const {
-    std::vector<uint8_t> out(BYTES_PER_SECTOR, 0x00);
-    size_t offset = static_cast<size_t>((track * SECTORS_PER_TRACK + sector)
-                                        * BYTES_PER_SECTOR);
-    if (offset + BYTES_PER_SECTOR <= image.size())
-        std::copy(image.begin() + static_cast<ptrdiff_t>(offset),
-                  image.begin() + static_cast<ptrdiff_t>(offset + BYTES_PER_SECTOR),
-                  out.begin());
-    return out;
-}
-
-bool FDC::Drive::write_sector(int track, int sector,
-                               const std::array<uint8_t, BYTES_PER_SECTOR>& data) {
-    size_t offset = static_cast<size_t>((track * SECTORS_PER_TRACK + sector)
-                                        * BYTES_PER_SECTOR);
-    if (offset + BYTES_PER_SECTOR > image.size()) {
-        // Extend image if needed (e.g. formatting a larger disk)
-        image.resize(offset + BYTES_PER_SECTOR, 0x00);
-    }
-    std::copy(data.begin(), data.end(),
-              image.begin() + static_cast<ptrdiff_t>(offset));
-    return true;
-}
-
 // ============================================================================
 // REGISTER READ
 // ============================================================================
 uint8_t FDC::read(uint16_t addr) {
     switch (addr) {
 
-    case 0x37EC:   // Status register — reading clears INTRQ
+    case 0x37EC: { // Status register — reading clears INTRQ
         intrq_ = false;
-        return status_;
+        uint8_t v = status_;
+        // ACCURATE: Type I status shows the real index hole as the disk turns.
+        // (ZERO_LATENCY approximates this in Bus::read().)
+        if (timing_ == Timing::ACCURATE && type1_status_
+                && !(status_ & ST_NOTREADY) && (now_ % T_PER_REV) < T_INDEX_WIDTH)
+            v |= ST_DRQ;
+        return v;
+    }
 
     case 0x37ED:
         return track_;
@@ -125,6 +342,17 @@ uint8_t FDC::read(uint16_t addr) {
         return sector_;
 
     case 0x37EF: {  // Data register — drives the byte-by-byte transfer
+        activity_t_ = now_;
+        if (timing_ == Timing::ACCURATE) {
+            // Bytes become readable one slot at a time (see run_events()).
+            // Completion is signalled after the CRC, not on the last read.
+            if (buf_len_ > 0 && !write_pending_ && buf_pos_ < next_byte_) {
+                data_ = buf_[static_cast<size_t>(buf_pos_++)];
+                if (buf_pos_ == 1) sector_write_flag_ = true;
+                status_ &= static_cast<uint8_t>(~ST_DRQ);
+            }
+            return data_;
+        }
         if (buf_len_ > 0 && buf_pos_ < buf_len_) {
             data_ = buf_[buf_pos_++];
             if (buf_pos_ == 1) sector_write_flag_ = true;  // first byte consumed — next RAM write is the sector destination
@@ -156,6 +384,7 @@ void FDC::write(uint16_t addr, uint8_t val) {
         break;
 
     case 0x37EC:   // Command register
+        activity_t_ = now_;
         execute_command(val);
         break;
 
@@ -169,12 +398,22 @@ void FDC::write(uint16_t addr, uint8_t val) {
 
     case 0x37EF:   // Data register write (Write Sector accumulation)
         data_ = val;
+        activity_t_ = now_;
+        if (timing_ == Timing::ACCURATE) {
+            // Accept the byte only while DRQ is up; the disk consumes it at
+            // its byte slot and the sector is committed after the CRC.
+            if (write_pending_ && buf_len_ > 0 && (status_ & ST_DRQ)
+                    && buf_pos_ < buf_len_) {
+                buf_[static_cast<size_t>(buf_pos_++)] = val;
+                status_ &= static_cast<uint8_t>(~ST_DRQ);
+            }
+            break;
+        }
         if (write_pending_ && buf_len_ > 0 && buf_pos_ < buf_len_) {
             buf_[static_cast<size_t>(buf_pos_++)] = val;
             if (buf_pos_ >= buf_len_) {
-                // All bytes received — commit sector to disk image
-                Drive* d = active_drive();
-                if (d) d->write_sector(write_track_, write_sector_, buf_);
+                // All bytes received — commit sector (or whole track) to the image
+                commit_write();
                 buf_len_       = 0;
                 write_pending_ = false;
                 status_       &= static_cast<uint8_t>(~(ST_BUSY | ST_DRQ));
@@ -196,7 +435,12 @@ void FDC::execute_command(uint8_t cmd) {
     buf_len_       = 0;
     buf_pos_       = 0;
     write_pending_ = false;
+    track_op_      = false;
     intrq_         = false;
+    phase_         = Phase::IDLE;
+    event_t_       = NEVER;
+    next_byte_     = 0;
+    type1_status_  = (cmd >> 4) <= 0x7 || (cmd >> 4) == 0xD;
 
     uint8_t type = cmd >> 4;
     switch (type) {
@@ -214,8 +458,8 @@ void FDC::execute_command(uint8_t cmd) {
     case 0xB:                          cmd_write_sector(cmd);         break;
     case 0xC:                          cmd_read_address(cmd);         break;
     case 0xD:                          cmd_force_interrupt(cmd);      break;
-    // 0xE = Read Track, 0xF = Write Track — not needed for boot/run
-    default:                           cmd_force_interrupt(0xD0);     break;
+    case 0xE:                          cmd_read_track(cmd);           break;
+    case 0xF:                          cmd_write_track(cmd);          break;
     }
     // (result logged per-command for interesting cases only)
 }
@@ -224,104 +468,114 @@ void FDC::execute_command(uint8_t cmd) {
 // TYPE I COMMANDS — HEAD POSITIONING
 // ============================================================================
 
-void FDC::cmd_restore(uint8_t /*cmd*/) {
+// Head movement time for a Type I command: r1r0 step rate per track moved,
+// plus the 10 ms settle when the V (verify) bit is set.
+static uint64_t type1_delay(uint8_t cmd, int steps) {
+    uint64_t t = static_cast<uint64_t>(steps) * STEP_MS[cmd & 0x03] * FDC::T_PER_MS;
+    if (cmd & 0x04) t += SETTLE_T;
+    return t;
+}
+
+void FDC::cmd_restore(uint8_t cmd) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
+    int steps     = d->head_track;
     d->head_track = 0;
     track_        = 0;
     // Motor is now running — clear NOTREADY.  Head is at track 0 → TRACK0.
-    status_       = ST_TRACK0;
-    intrq_        = true;
+    complete_after(type1_delay(cmd, steps), ST_TRACK0);
 }
 
-void FDC::cmd_seek(uint8_t /*cmd*/) {
+void FDC::cmd_seek(uint8_t cmd) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
+    // The head can reach any physical track; an unformatted one reads as RNF.
     int target = data_;
     if (target < 0)           target = 0;
-    if (target >= d->tracks)  target = d->tracks - 1;
+    if (target >= MAX_TRACKS) target = MAX_TRACKS - 1;
 
+    int steps     = std::abs(target - d->head_track);
     last_dir_     = (target > d->head_track) ? +1 : -1;
     d->head_track = target;
     track_        = static_cast<uint8_t>(target);
     // Motor is now running — clear NOTREADY.
-    status_       = (track_ == 0) ? ST_TRACK0 : 0x00;
-    intrq_        = true;
+    complete_after(type1_delay(cmd, steps), (track_ == 0) ? ST_TRACK0 : 0x00);
 }
 
-void FDC::cmd_step(uint8_t /*cmd*/, int dir, bool update_track) {
+void FDC::cmd_step(uint8_t cmd, int dir, bool update_track) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
     last_dir_ = dir;
     int next  = d->head_track + dir;
-    if (next < 0)          next = 0;
-    if (next >= d->tracks) next = d->tracks - 1;
+    if (next < 0)           next = 0;
+    if (next >= MAX_TRACKS) next = MAX_TRACKS - 1;
 
     d->head_track = next;
     if (update_track) track_ = static_cast<uint8_t>(next);
 
     // Motor is now running — clear NOTREADY.
-    status_ = (d->head_track == 0) ? ST_TRACK0 : 0x00;
-    intrq_  = true;
+    complete_after(type1_delay(cmd, 1), (d->head_track == 0) ? ST_TRACK0 : 0x00);
 }
 
 // ============================================================================
 // TYPE II COMMANDS — SECTOR READ / WRITE
 // ============================================================================
 
-void FDC::cmd_read_sector(uint8_t /*cmd*/) {
+void FDC::cmd_read_sector(uint8_t cmd) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
     int t = d->head_track;
     int s = sector_;
 
-    if (s >= SECTORS_PER_TRACK || t >= d->tracks) {
-        status_ = ST_RNF;
-        intrq_  = true;
+    int len = 0;
+    uint8_t dam = DiskImage::DAM_NORMAL;
+    const uint8_t* data = d->image.find_sector(t, s, len, dam);
+    if (!data) {
+        complete_after(RNF_T, ST_RNF);
         return;
     }
 
-    auto bytes = d->read_sector(t, s);
-    std::copy(bytes.begin(), bytes.end(), buf_.begin());
+    std::copy(data, data + len, buf_.begin());
     buf_pos_ = 0;
-    buf_len_ = BYTES_PER_SECTOR;
-
-    bool deleted = (t == 17);
+    buf_len_ = len;
 
     last_read_track_  = t;
     last_read_sector_ = s;
 
+    // Status bits 6-5 report the data address mark: FB=00, FA=01, F9=10, F8=11.
     // JV1 format: track 17 (directory track) is formatted with FA data address
     // marks on ALL sectors (S0 GAT through S9).  All other tracks use FB (normal).
     // This matches xtrs behaviour and is required by LDOS's module loader, which
     // checks RECTYPE to distinguish directory-track sectors from data sectors.
-    status_ = ST_BUSY | ST_DRQ | (deleted ? ST_RECTYPE : 0x00);
-
+    uint8_t rectype = static_cast<uint8_t>(((0xFB - dam) & 0x03) << 5);
+    start_transfer(data_field_time(*d, t, s, cmd), rectype);
 }
 
-void FDC::cmd_write_sector(uint8_t /*cmd*/) {
+void FDC::cmd_write_sector(uint8_t cmd) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
     int t = d->head_track;
     int s = sector_;
 
-    if (s >= SECTORS_PER_TRACK || t >= d->tracks) {
-        status_ = ST_RNF;
-        intrq_  = true;
+    int len = 0;
+    uint8_t dam = DiskImage::DAM_NORMAL;
+    if (!d->image.find_sector(t, s, len, dam)) {
+        complete_after(RNF_T, ST_RNF);
         return;
     }
 
     write_pending_  = true;
     write_track_    = t;
     write_sector_   = s;
+    write_dam_      = static_cast<uint8_t>(0xFB - (cmd & 0x03));   // a1a0 → FB..F8
     buf_pos_        = 0;
-    buf_len_        = BYTES_PER_SECTOR;
-    status_         = ST_BUSY | ST_DRQ;
+    buf_len_        = len;
+    start_transfer(data_field_time(*d, t, s, cmd), 0x00);
 }
 
 // ============================================================================
@@ -329,35 +583,94 @@ void FDC::cmd_write_sector(uint8_t /*cmd*/) {
 // ============================================================================
 // Returns the 6-byte sector ID for the next encountered sector header.
 // LDOS uses this to verify head position after a seek.
-void FDC::cmd_read_address(uint8_t /*cmd*/) {
+void FDC::cmd_read_address(uint8_t cmd) {
     Drive* d = active_drive();
     if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
 
-    // Synthesise an ID field for the "next" sector at the current head position.
-    // JV1 sectors are physically laid out using this interleave on a real disk.
+    auto layout = d->image.track_layout(d->head_track, false);
+    if (layout.empty()) {
+        complete_after(RNF_T, ST_RNF);
+        return;
+    }
+    int n = static_cast<int>(layout.size());
+
+    // Report an ID field from the track at the current head position.
     // LDOS uses Read Address to verify track position after a seek; it reads
     // back the track byte and ignores rotation-dependent sector ordering.
-    static constexpr uint8_t JV1_INTERLEAVE[10] = {0,5,1,6,2,7,3,8,4,9};
-    uint8_t trk = static_cast<uint8_t>(d->head_track);
-    // Return the logically-next interleaved sector.  We use sector_ as the
-    // index into the interleave table so successive Read Address calls cycle
-    // through realistic sector IDs without needing rotation simulation.
-    uint8_t sec = JV1_INTERLEAVE[sector_ % SECTORS_PER_TRACK];
-
-    buf_[0] = trk;    // Track
-    buf_[1] = 0x00;   // Side 0
-    buf_[2] = sec;    // Sector
-    buf_[3] = 0x01;   // Length code 1 = 256 bytes
-    buf_[4] = 0x00;   // CRC high (fake)
-    buf_[5] = 0x00;   // CRC low (fake)
+    uint64_t search = now_ + ((cmd & 0x04) ? SETTLE_T : 0);
+    uint64_t id_t   = NEVER;
+    int      slot   = 0;
+    if (timing_ == Timing::ACCURATE) {
+        // Whichever ID field reaches the head first.
+        for (int p = 0; p < n; p++) {
+            uint64_t t = next_id_time(search, p, n);
+            if (t < id_t) { id_t = t; slot = p; }
+        }
+    } else {
+        // Return the logically-next physical sector.  We use sector_ as the
+        // index into the track layout so successive Read Address calls cycle
+        // through realistic sector IDs without needing rotation simulation.
+        slot = sector_ % n;
+    }
+    const DiskImage::Sector& id = layout[static_cast<size_t>(slot)];
+
+    buf_[0] = id.track;   // Track
+    buf_[1] = id.side;    // Side
+    buf_[2] = id.id;      // Sector
+    buf_[3] = static_cast<uint8_t>(size_code(id.data.size()));   // Length code
+    buf_[4] = 0x00;       // CRC high (fake)
+    buf_[5] = 0x00;       // CRC low (fake)
     buf_pos_ = 0;
     buf_len_ = 6;
 
     // FD1771 (P1771 / Model I): track register ← track field from ID.
     // Sector register ← sector field from ID (P1771 datasheet, byte 3 of 6).
-    track_  = trk;
-    sector_ = sec;
-    status_ = ST_BUSY | ST_DRQ;
+    track_  = id.track;
+    sector_ = id.id;
+    start_transfer(id_t, 0x00);
+}
+
+// ============================================================================
+// TYPE III — READ TRACK / WRITE TRACK
+// ============================================================================
+// Both transfer one revolution (TRACK_BYTES) starting at the index pulse.
+// Read Track delivers a synthesised FM stream; Write Track collects the
+// formatter's stream and parses it into sectors when the revolution ends.
+void FDC::cmd_read_track(uint8_t cmd) {
+    Drive* d = active_drive();
+    if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
+
+    auto layout = d->image.track_layout(d->head_track, true);
+    build_track(layout, buf_.data(), TRACK_BYTES);
+    buf_pos_ = 0;
+    buf_len_ = TRACK_BYTES;
+    start_transfer(next_index_time(now_ + ((cmd & 0x04) ? SETTLE_T : 0)), 0x00);
+}
+
+void FDC::cmd_write_track(uint8_t cmd) {
+    Drive* d = active_drive();
+    if (!d) { status_ = ST_NOTREADY; intrq_ = true; return; }
+
+    write_pending_ = true;
+    track_op_      = true;
+    write_track_   = d->head_track;
+    buf_pos_       = 0;
+    buf_len_       = TRACK_BYTES;
+    start_transfer(next_index_time(now_ + ((cmd & 0x04) ? SETTLE_T : 0)), 0x00);
+}
+
+void FDC::commit_write() {
+    Drive* d = active_drive();
+    if (!d) return;
+    if (track_op_) {
+        auto secs = parse_track(buf_.data(), buf_pos_);
+        d->image.format_track(write_track_, std::move(secs));
+        track_op_ = false;
+    } else {
+        d->image.write_sector(write_track_, write_sector_, buf_.data(), buf_len_, write_dam_);
+    }
+    d->dirty      = true;
+    d->generation = ++generations_;
 }
 
 // ============================================================================
@@ -379,3 +692,165 @@ void FDC::cmd_force_interrupt(uint8_t cmd) {
         intrq_ = true;
     // Bits 0-2 relate to index pulses / ready transitions — not needed
 }
+
+// ============================================================================
+// ROTATIONAL TIMING — SCHEDULING
+// ============================================================================
+void FDC::reset_clock() {
+    now_ = 0;
+    activity_t_ = NEVER;
+    if (phase_ == Phase::IDLE) return;
+    // The T-state counter restarted under a command in flight: abort it the
+    // way Force Interrupt would so no event is left stranded in the future.
+    buf_len_       = 0;
+    write_pending_ = false;
+    phase_         = Phase::IDLE;
+    event_t_       = NEVER;
+    status_       &= static_cast<uint8_t>(~(ST_BUSY | ST_DRQ));
+}
+
+uint64_t FDC::next_id_time(uint64_t t, int slot, int nslots) {
+    uint64_t slot_t = (T_PER_REV - POST_INDEX_T) / static_cast<uint64_t>(std::max(nslots, 1));
+    uint64_t at = t - (t % T_PER_REV) + POST_INDEX_T
+                + static_cast<uint64_t>(slot) * slot_t;
+    return (at < t) ? at + T_PER_REV : at;
+}
+
+uint64_t FDC::data_field_time(const Drive& d, int t, int s, uint8_t cmd) const {
+    if (timing_ != Timing::ACCURATE) return now_;
+    auto layout = d.image.track_layout(t, false);
+    uint64_t search = now_ + ((cmd & 0x04) ? SETTLE_T : 0);
+    return next_id_time(search, slot_of_sector(layout, s), static_cast<int>(layout.size()))
+         + ID_TO_DATA_T;
+}
+
+uint64_t FDC::next_index_time(uint64_t t) {
+    uint64_t at = t - (t % T_PER_REV);
+    return (at < t) ? at + T_PER_REV : at;
+}
+
+void FDC::complete_after(uint64_t delay, uint8_t st) {
+    if (timing_ == Timing::ZERO_LATENCY) {
+        status_ = st;
+        intrq_  = true;
+        return;
+    }
+    status_      = ST_BUSY;
+    done_status_ = st;
+    phase_       = Phase::WAIT;
+    event_t_     = now_ + delay;
+}
+
+void FDC::start_transfer(uint64_t data_t, uint8_t extra) {
+    if (timing_ == Timing::ZERO_LATENCY) {
+        status_ = ST_BUSY | ST_DRQ | extra;
+        return;
+    }
+    // Reads raise DRQ as each byte arrives; writes ask for byte 0 at once
+    // (the controller wants it loaded before the data field starts).
+    status_     = ST_BUSY | extra | (write_pending_ ? ST_DRQ : 0x00);
+    data_t_     = data_t;
+    next_byte_  = 0;
+    phase_      = Phase::DATA;
+    event_t_    = data_t;
+}
+
+// Process every event due at or before now_.  DATA events fire once per byte
+// slot; the CRC event ends the command.
+void FDC::run_events() {
+    while (now_ >= event_t_) {
+        switch (phase_) {
+        case Phase::WAIT:
+            status_  = done_status_;
+            intrq_   = true;
+            phase_   = Phase::IDLE;
+            event_t_ = NEVER;
+            break;
+
+        case Phase::DATA: {
+            int k = next_byte_;
+            if (write_pending_) {
+                // Disk consumes byte k now; if the CPU hasn't supplied it, a
+                // zero byte is written and LOST DATA is flagged.
+                if (buf_pos_ <= k) {
+                    buf_[static_cast<size_t>(k)] = 0x00;
+                    buf_pos_ = k + 1;
+                    status_ |= ST_LOSTDATA;
+                }
+                next_byte_ = k + 1;
+                if (next_byte_ < buf_len_) status_ |= ST_DRQ;
+            } else {
+                // Byte k arrives; an unread byte k-1 is overrun.
+                if (buf_pos_ < k) {
+                    buf_pos_ = k;
+                    status_ |= ST_LOSTDATA;
+                }
+                next_byte_ = k + 1;
+                status_   |= ST_DRQ;
+            }
+            if (next_byte_ >= buf_len_) {
+                phase_   = Phase::CRC;
+                event_t_ = data_t_ + static_cast<uint64_t>(buf_len_ + 2) * T_PER_BYTE;
+            } else {
+                event_t_ = data_t_ + static_cast<uint64_t>(next_byte_) * T_PER_BYTE;
+            }
+            break;
+        }
+
+        case Phase::CRC:
+            if (buf_pos_ < buf_len_) status_ |= ST_LOSTDATA;  // last byte never read
+            if (write_pending_) commit_write();
+            buf_len_       = 0;
+            write_pending_ = false;
+            status_       &= static_cast<uint8_t>(~(ST_BUSY | ST_DRQ));
+            intrq_         = true;
+            phase_         = Phase::IDLE;
+            event_t_       = NEVER;
+            break;
+
+        case Phase::IDLE:
+            event_t_ = NEVER;
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// SNAPSHOT
+// ============================================================================
+void FDC::save_state(State& s) const {
+    s.status = status_;  s.track = track_;  s.sector = sector_;  s.data = data_;
+    s.drive_sel  = drive_sel_;
+    s.last_drive = last_drive_;
+    // Only the live part of the buffer matters
+    if (buf_len_ > 0)
+        std::copy(buf_.begin(), buf_.begin() + buf_len_, s.buf.begin());
+    s.buf_pos = buf_pos_;  s.buf_len = buf_len_;
+    s.write_pending = write_pending_;  s.track_op = track_op_;
+    s.write_track = write_track_;  s.write_sector = write_sector_;  s.write_dam = write_dam_;
+    s.intrq = intrq_;  s.sector_write_flag = sector_write_flag_;
+    s.last_read_track = last_read_track_;  s.last_read_sector = last_read_sector_;
+    s.last_dir = last_dir_;
+    s.phase = phase_;  s.now = now_;  s.event_t = event_t_;  s.activity_t = activity_t_;
+    s.data_t = data_t_;  s.done_status = done_status_;  s.next_byte = next_byte_;
+    s.type1_status = type1_status_;
+    for (int d = 0; d < DRIVES; d++) s.head_track[d] = drives_[d].head_track;
+}
+
+void FDC::load_state(const State& s) {
+    status_ = s.status;  track_ = s.track;  sector_ = s.sector;  data_ = s.data;
+    drive_sel_  = s.drive_sel;
+    last_drive_ = s.last_drive;
+    if (s.buf_len > 0)
+        std::copy(s.buf.begin(), s.buf.begin() + s.buf_len, buf_.begin());
+    buf_pos_ = s.buf_pos;  buf_len_ = s.buf_len;
+    write_pending_ = s.write_pending;  track_op_ = s.track_op;
+    write_track_ = s.write_track;  write_sector_ = s.write_sector;  write_dam_ = s.write_dam;
+    intrq_ = s.intrq;  sector_write_flag_ = s.sector_write_flag;
+    last_read_track_ = s.last_read_track;  last_read_sector_ = s.last_read_sector;
+    last_dir_ = s.last_dir;
+    phase_ = s.phase;  now_ = s.now;  event_t_ = s.event_t;  activity_t_ = s.activity_t;
+    data_t_ = s.data_t;  done_status_ = s.done_status;  next_byte_ = s.next_byte;
+    type1_status_ = s.type1_status;
+    for (int d = 0; d < DRIVES; d++) drives_[d].head_track = s.head_track[d];
+}
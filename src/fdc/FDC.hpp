@@ -12,14 +12,25 @@
 // Bus::interrupt_pending() combines both sources; reading 0x37E0 exposes which
 // fired (bit7=timer, bit6=FDC). DRQ is polled by software; no /WAIT hardware.
 //
-// JV1 disk image format: flat array of 256-byte sectors in track-major order.
-//   offset = (track × SECTORS_PER_TRACK + sector) × BYTES_PER_SECTOR
-// Supports up to 4 drives. TRSDOS/LDOS standard: 35 tracks, 10 sectors, SS/SD.
+// Disk images are JV1 (flat 256-byte sectors, 10 per track) or JV3 (per-sector
+// header, arbitrary layouts) — see DiskImage.hpp.  Supports up to 4 drives.
+// TRSDOS/LDOS standard: 35 tracks, 10 sectors, SS/SD.
+//
+// Write Track (format) accepts the raw FM byte stream — gaps, FE ID marks,
+// F8-FB data marks, F7 CRC requests — and turns it into sectors; Read Track
+// synthesises the same stream from the image.
+//
+// Timing: in ZERO_LATENCY mode (default) every command completes the moment
+// it is written.  In ACCURATE mode the disk rotates with the T-state clock
+// supplied by Bus::add_ticks(): Type I commands take step-rate time, sectors
+// are found when their ID field passes the head, DRQ rises once per byte time
+// (with LOST DATA if the CPU falls behind) and INTRQ fires after the CRC.
 #pragma once
 #include <array>
 #include <cstdint>
 #include <string>
 #include <vector>
+#include "DiskImage.hpp"
 
 class FDC {
 public:
@@ -27,9 +38,52 @@ public:
     static constexpr int SECTORS_PER_TRACK = 10;
     static constexpr int BYTES_PER_SECTOR  = 256;
     static constexpr int MAX_TRACKS        = 96;   // upper bound for bounds checks
+    static constexpr int TRACK_BYTES       = 3125; // raw FM bytes per revolution
+
+    // Rotational geometry in T-states (1.77408 MHz CPU, 300 RPM, FM 125 kbit/s)
+    static constexpr uint64_t T_PER_REV     = 354800;  // one revolution (200 ms)
+    static constexpr uint64_t T_INDEX_WIDTH =  17740;  // index hole ≈ 5% of a turn
+    static constexpr uint64_t T_PER_BYTE    =    114;  // 64 µs per FM byte
+    static constexpr uint64_t T_PER_MS      =   1774;
+
+    // How long after the last command or data byte the controller still
+    // counts as active (see is_active()).  Covers the gaps a DOS spends
+    // between sectors while booting or loading a file.
+    static constexpr uint64_t ACTIVITY_HOLD_T = 1000 * T_PER_MS;
+
+    enum class Timing { ZERO_LATENCY, ACCURATE };
+    void   set_timing(Timing t) { timing_ = t; }
+    Timing timing() const { return timing_; }
+
+    // Clock input, called from Bus::add_ticks() with the global T-state count.
+    // Only does work when a scheduled event (byte slot, completion) is due.
+    void advance(uint64_t now) { now_ = now; if (now >= event_t_) run_events(); }
+
+    // Abandon scheduled work when the bus clock restarts (soft/hard reset).
+    void reset_clock();
 
-    // Load a JV1 .dsk image into drive slot 0-3.  Returns false on error.
+    // Load a JV1, JV3 or IMD image into drive slot 0-3.  Returns false on error.
+    // A directory path mounts it as a synthetic LDOS data disk instead.
     bool load_disk(int drive, const std::string& path);
+    // Mount image bytes already in memory; `name` is only used for messages
+    // and get_disk_name().  save_disk() on such a drive writes to `name`.
+    bool load_disk_bytes(int drive, std::vector<uint8_t> bytes, const std::string& name);
+    // Mount an empty, unformatted image that will be saved to `path`.
+    bool new_disk(int drive, const std::string& path);
+    // Write the drive's image back to its file.  Returns false on error.
+    // Host-directory drives write through as they go; this is a no-op.
+    bool save_disk(int drive);
+    // True if the image has been written since it was loaded or saved.
+    bool is_dirty(int drive) const {
+        return drive >= 0 && drive < DRIVES && drives_[drive].dirty;
+    }
+    // Image replaced in memory by a rewind: it needs a save, and its content
+    // is again that of write generation `gen`.
+    void mark_rewound(int drive, uint64_t gen) {
+        if (drive < 0 || drive >= DRIVES || !drives_[drive].loaded) return;
+        drives_[drive].dirty      = true;
+        drives_[drive].generation = gen;
+    }
 
     // Memory-mapped register access called from Bus::read()/write().
     // addr range: 0x37EC-0x37EF  (drive select 0x37E0-0x37E3 handled by Bus)
@@ -51,9 +105,28 @@ public:
     // Set when a command completes; cleared when FDC status (0x37EC) is read.
     bool intrq_pending() const { return intrq_; }
 
+    // True while a command is in flight or one was issued / data moved within
+    // ACTIVITY_HOLD_T.  Status polls alone don't count, so a DOS that merely
+    // checks the drive from its idle loop doesn't keep the controller "busy".
+    bool is_active() const {
+        return phase_ != Phase::IDLE || buf_len_ > 0 ||
+               (activity_t_ != NEVER && now_ - activity_t_ < ACTIVITY_HOLD_T);
+    }
+
     // True while a Read Sector transfer is in progress (DRQ data being consumed).
     bool is_reading_sector() const { return buf_len_ > 0 && !write_pending_; }
 
+    // True while a Write Sector transfer is waiting for data bytes.
+    bool is_writing_sector() const { return buf_len_ > 0 && write_pending_; }
+
+    // True from a Write Sector or Write Track command until its data is
+    // stored in the image or the command ends without it.
+    bool write_pending() const { return write_pending_; }
+
+    // Side-effect-free status read (does NOT clear INTRQ).  Used by the
+    // fast disk path to test DRQ before committing to a block transfer.
+    uint8_t peek_status() const { return status_; }
+
     // Consume the first-write flag — returns true exactly once per sector read start.
     bool take_sector_write_flag() { return sector_write_flag_ ? (sector_write_flag_ = false, true) : false; }
 
@@ -64,6 +137,17 @@ public:
     // True if any drive has a disk loaded (used for expansion-interface detection).
     bool is_present() const;
 
+    // Content hash of the drive's current image (0 for an empty drive), for
+    // the boot cache key.  False for a host directory: its "content" is
+    // whatever the directory holds when a sector is read.
+    bool image_hash(int drive, uint64_t& out) const;
+    // Current image content serialised in its own format (empty if none).
+    std::vector<uint8_t> image_bytes(int drive) const;
+    // Changes on every mount and every sector or track write and is never
+    // reused, so an unchanged generation means unchanged content.  0 for an
+    // empty drive or a host directory (written through to the host).
+    uint64_t write_generation(int drive) const;
+
     // Set the CPU PC at the time of the current bus operation (for logging).
     void set_pc(uint16_t pc) { last_pc_ = pc; }
 
@@ -79,16 +163,14 @@ private:
     // DRIVE STATE
     // =========================================================================
     struct Drive {
-        std::vector<uint8_t> image;
-        int  head_track = 0;
-        int  tracks     = 0;   // actual track count, computed from image size on load
-        bool loaded     = false;
-
-        std::vector<uint8_t> read_sector(int track, int sector) const;
-        bool write_sector(int track, int sector,
-                          const std::array<uint8_t, BYTES_PER_SECTOR>& data);
+        DiskImage image;
+        int      head_track = 0;
+        bool     loaded     = false;
+        bool     dirty      = false;   // written since load/save
+        uint64_t generation = 0;       // see write_generation()
     };
     std::array<Drive, DRIVES> drives_;
+    uint64_t generations_ = 0;     // last generation handed out; not in State
 
     // =========================================================================
     // FD1771 REGISTERS
@@ -104,15 +186,18 @@ private:
     uint8_t drive_sel_ = 0;   // Drive select latch
     int     last_drive_ = 0;  // Last explicitly-selected drive (sticky after deselect)
 
-    // Sector transfer buffer — shared by Read Sector, Write Sector, Read Address
-    std::array<uint8_t, BYTES_PER_SECTOR> buf_{};
+    // Transfer buffer — shared by Read/Write Sector, Read Address and
+    // Read/Write Track (a whole raw track is the largest transfer).
+    std::array<uint8_t, TRACK_BYTES> buf_{};
     int  buf_pos_  = 0;
     int  buf_len_  = 0;
 
-    // Write Sector commit target (set when Write Sector command is issued)
-    bool write_pending_  = false;
-    int  write_track_    = 0;
-    int  write_sector_   = 0;
+    // Write Sector / Write Track commit target (set when the command is issued)
+    bool    write_pending_  = false;
+    bool    track_op_       = false;   // Write Track: buf_ holds a raw track stream
+    int     write_track_    = 0;
+    int     write_sector_   = 0;
+    uint8_t write_dam_      = DiskImage::DAM_NORMAL;
 
     bool intrq_ = false;   // Interrupt request pending
     bool sector_write_flag_ = false;  // Set on first FDC data byte read; cleared by Bus::write()
@@ -120,6 +205,23 @@ private:
     int  last_read_sector_  = 0;      // Sector of most recent Read Sector command
 
     int last_dir_ = 1;     // Last step direction (+1 = in, -1 = out)
+
+    // =========================================================================
+    // ROTATIONAL TIMING (ACCURATE mode only)
+    // =========================================================================
+    static constexpr uint64_t NEVER = UINT64_MAX;
+    enum class Phase { IDLE, WAIT, DATA, CRC };
+
+    Timing   timing_       = Timing::ZERO_LATENCY;
+    Phase    phase_        = Phase::IDLE;
+    uint64_t now_          = 0;       // Last T-state seen via advance()
+    uint64_t event_t_      = NEVER;   // When run_events() must next act
+    uint64_t activity_t_   = NEVER;   // Last command / data register access
+    uint8_t  done_status_  = 0;       // Status presented when a WAIT completes
+    uint64_t data_t_       = 0;       // T-state of byte 0 of the field in transfer
+    int      next_byte_    = 0;       // Next byte slot the disk will present/consume
+    bool     type1_status_ = false;   // Status shows Type I bits (bit 1 = INDEX)
+
     uint16_t last_pc_ = 0; // CPU PC at time of last bus write (for logging)
 
     std::array<std::string, DRIVES> disk_names_;  // Path of each loaded disk image
@@ -129,6 +231,28 @@ private:
     // =========================================================================
     int    current_drive() const;   // Index of selected drive, or -1
     Drive* active_drive();          // Pointer to selected drive, or nullptr
+    bool   load_host_dir(int drive, const std::string& path);
+    bool   mount(int drive, ImageCache::Bytes bytes, const std::string& path);
+
+    // Finish the current command after `delay` T-states with status `st`
+    // (immediately in ZERO_LATENCY mode).
+    void complete_after(uint64_t delay, uint8_t st);
+    // Begin a DRQ transfer of buf_len_ bytes whose first byte passes the head
+    // at `data_t` (immediately in ZERO_LATENCY mode).  `extra` is OR'd into
+    // the status for the life of the command (e.g. RECTYPE).
+    void start_transfer(uint64_t data_t, uint8_t extra);
+    // T-state at which the ID field of physical slot `slot` (of `nslots`
+    // evenly spaced around the track) next passes the head at or after `t`.
+    static uint64_t next_id_time(uint64_t t, int slot, int nslots);
+    // T-state at which the data field of sector `s` on track `t` of `d`
+    // reaches the head, searching from now (after the settle delay if the
+    // command's E bit is set).  ACCURATE mode only: otherwise now_, without
+    // building the track layout.
+    uint64_t data_field_time(const Drive& d, int t, int s, uint8_t cmd) const;
+    // T-state of the next index pulse at or after `t`.
+    static uint64_t next_index_time(uint64_t t);
+    void commit_write();   // store a completed Write Sector / Write Track
+    void run_events();
 
     // =========================================================================
     // COMMAND HANDLERS
@@ -146,7 +270,36 @@ private:
 
     // Type III — address/track
     void cmd_read_address(uint8_t cmd);
+    void cmd_read_track(uint8_t cmd);
+    void cmd_write_track(uint8_t cmd);
 
     // Type IV — force interrupt
     void cmd_force_interrupt(uint8_t cmd);
+
+public:
+    // =========================================================================
+    // SNAPSHOT (run-ahead)
+    // =========================================================================
+    // Controller registers, transfer buffer, head positions and the rotational
+    // clock.  Image contents and dirty flags are not included, so run-ahead
+    // stops before a write command can store anything (see write_pending()).
+    struct State {
+        uint8_t  status, track, sector, data, drive_sel;
+        int      last_drive;
+        std::array<uint8_t, TRACK_BYTES> buf;
+        int      buf_pos, buf_len;
+        bool     write_pending, track_op;
+        int      write_track, write_sector;
+        uint8_t  write_dam;
+        bool     intrq, sector_write_flag;
+        int      last_read_track, last_read_sector, last_dir;
+        Phase    phase;
+        uint64_t now, event_t, activity_t, data_t;
+        uint8_t  done_status;
+        int      next_byte;
+        bool     type1_status;
+        std::array<int, DRIVES> head_track;
+    };
+    void save_state(State& s) const;
+    void load_state(const State& s);
 };
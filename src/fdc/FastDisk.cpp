@@ -0,0 +1,98 @@
+// src/fdc/FastDisk.cpp
+// DRQ copy-loop fast path — see FastDisk.hpp for the recognised code shape.
+#include "FastDisk.hpp"
+#include "FDC.hpp"
+#include "../cpu/z80.hpp"
+#include "../system/Bus.hpp"
+
+static constexpr uint16_t FDC_STATUS = 0x37EC;
+static constexpr uint16_t FDC_DATA   = 0x37EF;
+static constexpr uint8_t  ST_DRQ     = 0x02;
+
+// ============================================================================
+// SIGNATURE MATCH
+// ============================================================================
+FastDisk::LoopKind FastDisk::match_loop(uint16_t pc, const Bus& bus) {
+    auto b = [&](int o) { return bus.peek(static_cast<uint16_t>(pc + o)); };
+
+    if (b(0) != 0x7E) return LoopKind::NONE;                       // ld a,(hl)
+    if (b(1) != 0xCB || b(2) != 0x4F) return LoopKind::NONE;       // bit 1,a
+    if (b(3) != 0x28) return LoopKind::NONE;                       // jr z,EXIT
+    if (b(5) != 0xF3) return LoopKind::NONE;                       // di
+    if (b(8) != 0x03) return LoopKind::NONE;                       // inc bc
+    if (b(9) != 0xC3 || (b(10) | (b(11) << 8)) != pc)              // jp LOOP
+        return LoopKind::NONE;
+
+    if (b(6) == 0x1A && b(7) == 0x02) return LoopKind::READ;       // ld a,(de); ld (bc),a
+    if (b(6) == 0x0A && b(7) == 0x12) return LoopKind::WRITE;      // ld a,(bc); ld (de),a
+    return LoopKind::NONE;
+}
+
+// ============================================================================
+// INTERCEPT
+// ============================================================================
+bool FastDisk::ready(uint16_t pc, const Z80& cpu, Bus& bus) {
+    // Only meaningful while the loop registers point at the FDC.
+    if (cpu.get_hl() != FDC_STATUS || cpu.get_de() != FDC_DATA) return false;
+
+    // With rotational timing each byte has its own DRQ slot; the loop must
+    // run in real time, so the fast path only applies to zero-latency I/O.
+    FDC& fdc = bus.fdc();
+    if (fdc.timing() != FDC::Timing::ZERO_LATENCY) return false;
+    if (!(fdc.peek_status() & ST_DRQ)) return false;
+
+    LoopKind kind = match_loop(pc, bus);
+    if (kind == LoopKind::READ)  return fdc.is_reading_sector();
+    if (kind == LoopKind::WRITE) return fdc.is_writing_sector();
+    return false;
+}
+
+bool FastDisk::handle_intercept(uint16_t pc, Z80& cpu, Bus& bus,
+                                uint64_t& frame_ts) {
+    if (!enabled_ || !ready(pc, cpu, bus)) return false;
+    FDC&     fdc  = bus.fdc();
+    LoopKind kind = match_loop(pc, bus);
+
+    // Replay the loop body for every byte the controller has ready.  Each
+    // iteration reads the status register exactly as "ld a,(hl)" would (so
+    // INTRQ clears at the same point) and then moves one data byte.
+    uint16_t bc     = cpu.get_bc();
+    uint8_t  a      = cpu.get_a();
+    uint8_t  status = 0;
+    int      n      = 0;
+    while (fdc.peek_status() & ST_DRQ) {
+        status = fdc.read(FDC_STATUS);
+        if (kind == LoopKind::READ) {
+            a = fdc.read(FDC_DATA);
+            bus.write(bc, a);
+        } else {
+            a = bus.peek(bc);
+            fdc.write(FDC_DATA, a);
+        }
+        bc++;
+        n++;
+    }
+    if (n == 0) return false;
+
+    // Flags come from the last "bit 1,a" on a status byte with DRQ set:
+    // Z=P/V=0, H=1, N=0, S=0, F3/F5 from the operand, C unchanged.
+    uint8_t f = static_cast<uint8_t>((cpu.get_f() & FLAG_C) | FLAG_H |
+                                     (status & (FLAG_F3 | FLAG_F5)));
+    uint8_t r = cpu.get_r();
+    r = static_cast<uint8_t>((r & 0x80) | ((r + n * M1_PER_BYTE) & 0x7F));
+
+    cpu.set_a(a);
+    cpu.set_f(f);
+    cpu.set_bc(bc);
+    cpu.set_r(r);
+    cpu.set_iff1(false);          // "di" executed on every iteration
+    cpu.set_iff2(false);
+    cpu.set_ei_pending(false);
+    cpu.set_pc(pc);               // back at LOOP, as after "jp LOOP"
+
+    int ticks = n * T_PER_BYTE;
+    bus.add_ticks(ticks);
+    frame_ts += static_cast<uint64_t>(ticks);
+    if (n >= FDC::BYTES_PER_SECTOR) sectors_++;
+    return true;
+}
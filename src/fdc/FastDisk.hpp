@@ -0,0 +1,61 @@
+// src/fdc/FastDisk.hpp
+// High-level fast path for the DOS sector-transfer (DRQ polling) loop.
+//
+// LDOS (and TRSDOS-style drivers derived from the same code) move each
+// 256-byte sector through the FD1771 data register one byte at a time:
+//
+//   LOOP: 7E        ld   a,(hl)     ; HL = 0x37EC  FDC status
+//         CB 4F     bit  1,a        ; DRQ?
+//         28 xx     jr   z,EXIT     ; no DRQ → exit/wait path
+//         F3        di
+//         1A        ld   a,(de)     ; DE = 0x37EF  (read)   | 0A ld a,(bc)
+//         02        ld   (bc),a     ;                       | 12 ld (de),a  (write)
+//         03        inc  bc
+//         C3 LOOP   jp   LOOP
+//
+// The loop is self-modified at boot (see LDOS_BOOT_INVESTIGATION.md), so it
+// is recognised by code signature at the current PC rather than by a fixed
+// address.  When the CPU reaches the loop head with DRQ asserted, the whole
+// remaining transfer is performed in one host step: bytes move between the
+// FDC buffer and RAM, and A/F/BC/R/IFF/T-states are left exactly as the
+// interpreter would have left them after the last "jp LOOP".  The final
+// status poll and exit path are then executed normally by the interpreter.
+#pragma once
+#include <cstdint>
+
+class Z80;
+class Bus;
+
+class FastDisk {
+public:
+    // Per-byte cost of one loop iteration, as charged by Z80::step():
+    //   ld a,(hl) 7 + bit 1,a 8 + jr z (not taken) 7 + di 4
+    //   + ld a,(de) 7 + ld (bc),a 7 + inc bc 6 + jp 10  = 56 T
+    static constexpr int T_PER_BYTE = 56;
+    // M1 cycles per iteration (CB prefix counts twice) — advances R.
+    static constexpr int M1_PER_BYTE = 9;
+
+    void set_enabled(bool on) { enabled_ = on; }
+    bool enabled() const { return enabled_; }
+
+    // Call every step before cpu.step().  If pc is the head of a DRQ copy
+    // loop and the FDC has data ready, performs the whole transfer, charges
+    // the T-states to bus and frame_ts, and returns true (caller must skip
+    // cpu.step() for this cycle).
+    bool handle_intercept(uint16_t pc, Z80& cpu, Bus& bus, uint64_t& frame_ts);
+
+    // True if pc is the head of a DRQ copy loop with data ready: what
+    // handle_intercept() would take when enabled.
+    static bool ready(uint16_t pc, const Z80& cpu, Bus& bus);
+
+    // Number of sectors completed via the fast path (for diagnostics).
+    uint64_t sectors_transferred() const { return sectors_; }
+
+private:
+    enum class LoopKind { NONE, READ, WRITE };
+
+    bool     enabled_ = false;
+    uint64_t sectors_ = 0;
+
+    static LoopKind match_loop(uint16_t pc, const Bus& bus);
+};
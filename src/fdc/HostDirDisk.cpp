@@ -0,0 +1,479 @@
+// src/fdc/HostDirDisk.cpp
+// Host directory as a synthetic LDOS disk — see HostDirDisk.hpp.
+#include "HostDirDisk.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// LDOS CONSTANTS
+// ============================================================================
+static constexpr int     DIR_SECTORS      = 8;       // sectors 2-9 of the dir cylinder
+static constexpr int     ENTRY_BYTES      = 32;
+static constexpr int     ENTRIES_PER_SEC  = HostDirDisk::SECTOR_BYTES / ENTRY_BYTES;
+static constexpr int     EXTENTS_PER_FPDE = 4;
+static constexpr int     MAX_EXTENT_GRANS = 32;      // 5-bit count field
+static constexpr int     DEC_BOOT         = 0;       // BOOT/SYS: first slot of sector 2
+static constexpr int     DEC_DIR          = 1;       // DIR/SYS:  first slot of sector 3
+
+static constexpr uint8_t ATTR_ACTIVE      = 0x10;
+static constexpr uint8_t ATTR_FXDE        = 0x80;
+static constexpr uint8_t ATTR_BOOT        = 0x5E;    // SYS | active | invisible | prot 6
+static constexpr uint8_t ATTR_DIR         = 0x5D;    // SYS | active | invisible | prot 5
+static constexpr uint8_t ATTR_FILE        = ATTR_ACTIVE;
+static constexpr uint16_t BLANK_PASSWORD  = 0x4296;  // hash of an all-blank password
+static constexpr uint16_t MASTER_PASSWORD = 0x42E0;  // hash of "PASSWORD"
+static constexpr uint8_t  FILL_BYTE       = 0xE5;    // FORMAT's fill for unused sectors
+
+static constexpr int TOTAL_GRANS   = HostDirDisk::TRACKS * HostDirDisk::GRANS_PER_CYL;
+static constexpr int GRAN_BYTES    = HostDirDisk::GRAN_SECTORS * HostDirDisk::SECTOR_BYTES;
+static constexpr int FIRST_DIR_GRAN = HostDirDisk::DIR_TRACK * HostDirDisk::GRANS_PER_CYL;
+
+// Lay `need` granules out from `cursor`, skipping the directory cylinder.
+// Fails (leaving cursor alone) if the disk or the FPDE's extent slots run out.
+static bool allocate(int& cursor, int need, std::vector<int>& firsts, std::vector<int>& counts) {
+    int g = cursor;
+    while (need > 0) {
+        if (g >= FIRST_DIR_GRAN && g < FIRST_DIR_GRAN + HostDirDisk::GRANS_PER_CYL)
+            g = FIRST_DIR_GRAN + HostDirDisk::GRANS_PER_CYL;
+        if (g >= TOTAL_GRANS) return false;
+        int limit = (g < FIRST_DIR_GRAN) ? FIRST_DIR_GRAN : TOTAL_GRANS;
+        int run   = std::min({need, MAX_EXTENT_GRANS, limit - g});
+        firsts.push_back(g);
+        counts.push_back(run);
+        g    += run;
+        need -= run;
+    }
+    if (static_cast<int>(firsts.size()) > EXTENTS_PER_FPDE) return false;
+    cursor = g;
+    return true;
+}
+
+// Ending Record Number / EOF offset, as LDOS stores a file's length.
+static uint32_t size_from_ern(uint16_t ern, uint8_t eof) {
+    if (ern == 0) return 0;
+    return eof ? (static_cast<uint32_t>(ern) - 1) * 256 + eof : static_cast<uint32_t>(ern) * 256;
+}
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+// ============================================================================
+// NAMES
+// ============================================================================
+// The LDOS / TRSDOS 6 filename hash kept in the HIT.
+uint8_t HostDirDisk::name_hash(const std::string& name11) {
+    uint8_t h = 0;
+    for (char c : name11) {
+        uint8_t a = static_cast<uint8_t>(static_cast<uint8_t>(c) ^ h);
+        h = static_cast<uint8_t>((a << 1) | (a >> 7));
+    }
+    return h ? h : 1;
+}
+
+// "game.cmd" → "GAME    CMD".  Empty if no legal LDOS name can be formed.
+std::string HostDirDisk::ldos_name(const std::string& host_name) {
+    size_t dot = host_name.rfind('.');
+    std::string stem = host_name.substr(0, dot);
+    std::string ext  = (dot == std::string::npos) ? "" : host_name.substr(dot + 1);
+
+    auto clean = [](const std::string& s, size_t max) {
+        std::string out;
+        for (char c : s) {
+            if (out.size() == max) break;
+            if (std::isalnum(static_cast<unsigned char>(c)))
+                out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return out;
+    };
+    std::string n = clean(stem, 8);
+    std::string e = clean(ext, 3);
+    if (n.empty() || !std::isalpha(static_cast<unsigned char>(n[0]))) return "";
+    if (!e.empty() && !std::isalpha(static_cast<unsigned char>(e[0]))) return "";
+    n.resize(8, ' ');
+    e.resize(3, ' ');
+    return n + e;
+}
+
+// "GAME    CMD" → "game.cmd", for files the guest creates.
+std::string HostDirDisk::host_name_for(const std::string& name11) {
+    auto lower = [](std::string s) {
+        while (!s.empty() && s.back() == ' ') s.pop_back();
+        for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return s;
+    };
+    std::string n = lower(name11.substr(0, 8));
+    std::string e = lower(name11.substr(8, 3));
+    return e.empty() ? n : n + "." + e;
+}
+
+std::string HostDirDisk::host_path(const std::string& name) const {
+    return (fs::path(dir_) / name).string();
+}
+
+// ============================================================================
+// MOUNT
+// ============================================================================
+bool HostDirDisk::mount(const std::string& dir) {
+    std::error_code ec;
+    if (!fs::is_directory(dir, ec)) return false;
+
+    dir_ = dir;
+    files_.clear();
+    overlay_.clear();
+
+    std::vector<std::string> names;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (!entry.is_regular_file(ec)) continue;
+        std::string n = entry.path().filename().string();
+        if (!n.empty() && n[0] != '.') names.push_back(n);
+    }
+    if (ec) return false;
+    std::sort(names.begin(), names.end());
+
+    // Free slots in DEC order; 0 and 1 belong to BOOT/SYS and DIR/SYS.
+    std::vector<int> decs;
+    for (int e = 0; e < ENTRIES_PER_SEC; e++)
+        for (int s = 0; s < DIR_SECTORS; s++) {
+            int dec = e * 32 + s;
+            if (dec != DEC_BOOT && dec != DEC_DIR) decs.push_back(dec);
+        }
+
+    int cursor = 1;   // granule 0 is BOOT/SYS
+    for (const auto& n : names) {
+        std::string name11 = ldos_name(n);
+        if (name11.empty()) {
+            std::cerr << "[HOSTDIR] Skipping " << n << ": no valid LDOS name\n";
+            continue;
+        }
+        bool dup = std::any_of(files_.begin(), files_.end(),
+                               [&](const File& f) { return f.name11 == name11; });
+        if (dup) {
+            std::cerr << "[HOSTDIR] Skipping " << n << ": duplicate LDOS name\n";
+            continue;
+        }
+        if (files_.size() == decs.size()) {
+            std::cerr << "[HOSTDIR] Skipping " << n << ": directory full\n";
+            continue;
+        }
+        uintmax_t size = fs::file_size(fs::path(dir) / n, ec);
+        if (ec) continue;
+
+        int need = static_cast<int>((size + GRAN_BYTES - 1) / GRAN_BYTES);
+        std::vector<int> firsts, counts;
+        if (size > 0xFFFF * 256u || !allocate(cursor, need, firsts, counts)) {
+            std::cerr << "[HOSTDIR] Skipping " << n << ": disk full\n";
+            continue;
+        }
+        File f;
+        f.host_name = n;
+        f.name11    = name11;
+        f.size      = static_cast<uint32_t>(size);
+        f.dec       = decs[files_.size()];
+        for (size_t i = 0; i < firsts.size(); i++) f.extents.push_back({firsts[i], counts[i]});
+        files_.push_back(std::move(f));
+    }
+
+    // GAT disk name: the directory's own name, LDOS-style.
+    fs::path p(dir);
+    if (p.filename().empty()) p = p.parent_path();
+    disk_name_.clear();
+    for (char c : p.filename().string()) {
+        if (disk_name_.size() == 8) break;
+        if (std::isalnum(static_cast<unsigned char>(c)))
+            disk_name_ += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    if (disk_name_.empty()) disk_name_ = "HOSTDIR";
+    disk_name_.resize(8, ' ');
+
+    char date[16];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%m/%d/%y", std::localtime(&now));
+    disk_date_ = date;
+    disk_date_.resize(8, ' ');
+
+    rebuild_owners();
+    return true;
+}
+
+void HostDirDisk::rebuild_owners() {
+    owner_.assign(static_cast<size_t>(TRACKS * SECTORS), -1);
+    owner_off_.assign(static_cast<size_t>(TRACKS * SECTORS), 0);
+    for (size_t i = 0; i < files_.size(); i++) {
+        uint32_t offset = 0;
+        for (const auto& x : files_[i].extents) {
+            for (int g = x.gran; g < x.gran + x.count && g < TOTAL_GRANS; g++) {
+                int first = (g / GRANS_PER_CYL) * SECTORS + (g % GRANS_PER_CYL) * GRAN_SECTORS;
+                for (int s = 0; s < GRAN_SECTORS; s++) {
+                    owner_[static_cast<size_t>(first + s)]     = static_cast<int>(i);
+                    owner_off_[static_cast<size_t>(first + s)] = offset;
+                    offset += SECTOR_BYTES;
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// SECTOR GENERATION
+// ============================================================================
+static void put_fpde(uint8_t* p, uint8_t attr, const std::string& name11, uint32_t size,
+                     const std::vector<std::pair<int, int>>& extents) {
+    std::memset(p, 0, ENTRY_BYTES);
+    p[0] = attr;
+    p[3] = static_cast<uint8_t>(size & 0xFF);          // EOF offset
+    p[4] = 0;                                          // LRL 256
+    std::memcpy(p + 5, name11.data(), 11);
+    put16(p + 16, BLANK_PASSWORD);                     // update password
+    put16(p + 18, BLANK_PASSWORD);                     // access password
+    put16(p + 20, static_cast<uint16_t>((size + 255) / 256));   // ERN
+    std::memset(p + 22, 0xFF, ENTRY_BYTES - 22);
+    for (size_t i = 0; i < extents.size() && i < EXTENTS_PER_FPDE; i++) {
+        auto [gran, count] = extents[i];
+        p[22 + i * 2] = static_cast<uint8_t>(gran / HostDirDisk::GRANS_PER_CYL);
+        p[23 + i * 2] = static_cast<uint8_t>(((gran % HostDirDisk::GRANS_PER_CYL) << 5) | (count - 1));
+    }
+}
+
+void HostDirDisk::build_system_sector(int track, int sector, uint8_t* out) const {
+    std::memset(out, 0, SECTOR_BYTES);
+
+    if (track == 0) {
+        // Data disk boot sector: the DOS only wants the directory cylinder.
+        // Booting it just parks the CPU (DI; JR $).
+        const uint8_t boot[] = {0x00, 0xFE, DIR_TRACK, 0xF3, 0x18, 0xFE};
+        if (sector == 0) std::memcpy(out, boot, sizeof(boot));
+        return;
+    }
+
+    if (sector == 0) {                                 // GAT
+        std::vector<uint8_t> used(TRACKS, 0);
+        auto mark = [&](int g, int n) {
+            for (int i = g; i < g + n && i < TOTAL_GRANS; i++)
+                used[static_cast<size_t>(i / GRANS_PER_CYL)] |= static_cast<uint8_t>(1u << (i % GRANS_PER_CYL));
+        };
+        mark(0, 1);
+        mark(FIRST_DIR_GRAN, GRANS_PER_CYL);
+        for (const auto& f : files_)
+            for (const auto& x : f.extents) mark(x.gran, x.count);
+
+        const uint8_t spare = static_cast<uint8_t>(0xFF << GRANS_PER_CYL);
+        std::memset(out, 0xFF, 0xCB);
+        for (int c = 0; c < TRACKS; c++) {
+            out[c]        = spare | used[static_cast<size_t>(c)];
+            out[0x60 + c] = spare;                     // lockout: all present
+        }
+        out[0xCB] = 0x53;                              // LDOS 5.3
+        out[0xCC] = TRACKS - 35;                       // cylinders beyond 35
+        out[0xCD] = 0x80 | (GRANS_PER_CYL - 1);        // SD, 1 side, data disk
+        put16(out + 0xCE, MASTER_PASSWORD);
+        std::memcpy(out + 0xD0, disk_name_.data(), 8);
+        std::memcpy(out + 0xD8, disk_date_.data(), 8);
+        out[0xE0] = 0x0D;                              // no AUTO command
+        std::memset(out + 0xE1, ' ', SECTOR_BYTES - 0xE1);
+        return;
+    }
+
+    if (sector == 1) {                                 // HIT
+        out[DEC_BOOT] = name_hash("BOOT    SYS");
+        out[DEC_DIR]  = name_hash("DIR     SYS");
+        for (const auto& f : files_) out[f.dec] = name_hash(f.name11);
+        return;
+    }
+
+    if (sector - 2 >= DIR_SECTORS) {
+        std::memset(out, FILL_BYTE, SECTOR_BYTES);
+        return;
+    }
+    for (int e = 0; e < ENTRIES_PER_SEC; e++) {
+        int dec = e * 32 + (sector - 2);
+        uint8_t* p = out + e * ENTRY_BYTES;
+        if (dec == DEC_BOOT) {
+            put_fpde(p, ATTR_BOOT, "BOOT    SYS", GRAN_BYTES, {{0, 1}});
+        } else if (dec == DEC_DIR) {
+            put_fpde(p, ATTR_DIR, "DIR     SYS", SECTORS * SECTOR_BYTES,
+                     {{FIRST_DIR_GRAN, GRANS_PER_CYL}});
+        } else {
+            for (const auto& f : files_) {
+                if (f.dec != dec) continue;
+                std::vector<std::pair<int, int>> ext;
+                for (const auto& x : f.extents) ext.emplace_back(x.gran, x.count);
+                put_fpde(p, ATTR_FILE, f.name11, f.size, ext);
+            }
+        }
+    }
+}
+
+void HostDirDisk::read_file_sector(const File& f, uint32_t offset, uint8_t* out) const {
+    std::memset(out, 0, SECTOR_BYTES);
+    if (offset >= f.size) return;
+    std::ifstream in(host_path(f.host_name), std::ios::binary);
+    if (!in) return;
+    in.seekg(offset);
+    in.read(reinterpret_cast<char*>(out), SECTOR_BYTES);
+}
+
+// ============================================================================
+// SECTOR ACCESS
+// ============================================================================
+const uint8_t* HostDirDisk::read_sector(int track, int sector) {
+    if (track < 0 || track >= TRACKS || sector < 0 || sector >= SECTORS) return nullptr;
+    uint32_t index = static_cast<uint32_t>(track * SECTORS + sector);
+
+    auto it = overlay_.find(index);
+    if (it != overlay_.end()) return it->second.data();
+
+    int owner = owner_[index];
+    if (track == DIR_TRACK || (track == 0 && sector < GRAN_SECTORS))
+        build_system_sector(track, sector, scratch_.data());
+    else if (owner >= 0)
+        read_file_sector(files_[static_cast<size_t>(owner)], owner_off_[index], scratch_.data());
+    else
+        scratch_.fill(FILL_BYTE);
+    return scratch_.data();
+}
+
+bool HostDirDisk::write_sector(int track, int sector, const uint8_t* data) {
+    if (track < 0 || track >= TRACKS || sector < 0 || sector >= SECTORS) return false;
+    uint32_t index = static_cast<uint32_t>(track * SECTORS + sector);
+    std::copy(data, data + SECTOR_BYTES, overlay_[index].begin());
+
+    // Write through what lies inside the file's known length; anything past
+    // EOF waits in the overlay until the directory says the file grew.
+    int owner = owner_[index];
+    if (owner >= 0) {
+        const File& f = files_[static_cast<size_t>(owner)];
+        uint32_t off  = owner_off_[index];
+        if (off < f.size) {
+            std::fstream io(host_path(f.host_name), std::ios::binary | std::ios::in | std::ios::out);
+            io.seekp(off);
+            io.write(reinterpret_cast<const char*>(data),
+                     std::min<std::streamsize>(SECTOR_BYTES, f.size - off));
+            if (!io) std::cerr << "[HOSTDIR] Write to " << f.host_name << " failed\n";
+        }
+    }
+    if (track == DIR_TRACK && sector >= 2 && sector - 2 < DIR_SECTORS) sync_directory();
+    return true;
+}
+
+// ============================================================================
+// DIRECTORY WRITE-BACK
+// ============================================================================
+std::vector<uint8_t> HostDirDisk::gather(const std::vector<Extent>& extents, uint32_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size);
+    for (const auto& x : extents) {
+        for (int g = x.gran; g < x.gran + x.count && g < TOTAL_GRANS; g++) {
+            for (int s = 0; s < GRAN_SECTORS; s++) {
+                if (out.size() >= size) return out;
+                const uint8_t* p = read_sector(g / GRANS_PER_CYL, (g % GRANS_PER_CYL) * GRAN_SECTORS + s);
+                size_t n = std::min<size_t>(SECTOR_BYTES, size - out.size());
+                out.insert(out.end(), p, p + n);
+            }
+        }
+    }
+    out.resize(size, 0x00);
+    return out;
+}
+
+// Compare the directory the DOS has just written against the mapped files
+// and bring the host directory in line.
+void HostDirDisk::sync_directory() {
+    std::array<std::array<uint8_t, SECTOR_BYTES>, DIR_SECTORS> dir;
+    for (int s = 0; s < DIR_SECTORS; s++) {
+        const uint8_t* p = read_sector(DIR_TRACK, s + 2);
+        std::copy(p, p + SECTOR_BYTES, dir[static_cast<size_t>(s)].begin());
+    }
+    auto entry = [&](int dec) -> const uint8_t* {
+        int s = dec & 0x1F, e = dec >> 5;
+        if (s >= DIR_SECTORS || e >= ENTRIES_PER_SEC) return nullptr;
+        return dir[static_cast<size_t>(s)].data() + e * ENTRY_BYTES;
+    };
+
+    std::vector<bool> live(files_.size(), false);
+    for (int e = 0; e < ENTRIES_PER_SEC; e++) {
+        for (int s = 0; s < DIR_SECTORS; s++) {
+            int dec = e * 32 + s;
+            if (dec == DEC_BOOT || dec == DEC_DIR) continue;
+            const uint8_t* p = entry(dec);
+            if ((p[0] & (ATTR_ACTIVE | ATTR_FXDE)) != ATTR_ACTIVE) continue;
+
+            std::string name11(reinterpret_cast<const char*>(p + 5), 11);
+            uint32_t size = size_from_ern(static_cast<uint16_t>(p[20] | (p[21] << 8)), p[3]);
+
+            // Extents, following FXDE links (byte 30 = FE, byte 31 = DEC).
+            std::vector<Extent> ext;
+            const uint8_t* q = p;
+            for (int hops = 0; q && hops < 8; hops++) {
+                for (int i = 0; i < EXTENTS_PER_FPDE; i++) {
+                    const uint8_t* x = q + 22 + i * 2;
+                    if (x[0] >= 0xFE) break;
+                    ext.push_back({x[0] * GRANS_PER_CYL + (x[1] >> 5), (x[1] & 0x1F) + 1});
+                }
+                q = (q[30] == 0xFE) ? entry(q[31]) : nullptr;
+            }
+
+            bool fresh = false;
+            auto it = std::find_if(files_.begin(), files_.end(),
+                                   [&](const File& f) { return f.dec == dec; });
+            if (it == files_.end()) {
+                File f;
+                f.host_name = host_name_for(name11);
+                f.name11    = name11;
+                f.dec       = dec;
+                std::error_code ec;
+                if (f.host_name.empty() || fs::exists(host_path(f.host_name), ec)) {
+                    std::cerr << "[HOSTDIR] Not creating " << f.host_name
+                              << ": name unusable or already on the host\n";
+                    continue;
+                }
+                files_.push_back(std::move(f));
+                live.push_back(false);
+                fresh = true;
+                it = files_.end() - 1;
+                std::cout << "[HOSTDIR] Created " << it->host_name << "\n";
+            }
+            live[static_cast<size_t>(it - files_.begin())] = true;
+
+            if (it->name11 != name11) {
+                std::string to = host_name_for(name11);
+                std::error_code ec;
+                if (!to.empty() && !fs::exists(host_path(to), ec)) {
+                    fs::rename(host_path(it->host_name), host_path(to), ec);
+                    if (!ec) {
+                        std::cout << "[HOSTDIR] Renamed " << it->host_name << " -> " << to << "\n";
+                        it->host_name = to;
+                    }
+                }
+                it->name11 = name11;
+            }
+
+            if (fresh || it->extents != ext || it->size != size) {
+                std::vector<uint8_t> bytes = gather(ext, size);
+                std::ofstream out(host_path(it->host_name), std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(bytes.data()),
+                          static_cast<std::streamsize>(bytes.size()));
+                if (!out) std::cerr << "[HOSTDIR] Write to " << it->host_name << " failed\n";
+                it->extents = std::move(ext);
+                it->size    = size;
+            }
+        }
+    }
+
+    // Entries the DOS removed: stop mapping them, but keep the host file.
+    for (size_t i = files_.size(); i-- > 0; ) {
+        if (live[i]) continue;
+        std::cout << "[HOSTDIR] " << files_[i].host_name
+                  << " removed from directory (host file kept)\n";
+        files_.erase(files_.begin() + static_cast<ptrdiff_t>(i));
+    }
+    rebuild_owners();
+}
@@ -0,0 +1,90 @@
+// src/fdc/HostDirDisk.hpp
+// A host directory presented to the guest as an LDOS 5.3 data diskette.
+//
+// Mounting a directory instead of an image file builds a synthetic 40-track
+// single-density disk: every regular file in the directory (not recursive)
+// gets an LDOS name, a directory entry and a run of granules.  Nothing is
+// copied at mount time — the GAT, HIT and directory sectors are generated
+// from the allocation plan when the DOS reads them, and file sectors are read
+// from the host file on demand.
+//
+// Layout (same as LDOS FORMAT on SSSD media):
+//
+//   cyl 0  sec 0       boot sector; byte 2 = directory cylinder
+//   cyl 17 sec 0       GAT  — granule allocation + lockout bits, disk name
+//   cyl 17 sec 1       HIT  — filename hash per directory slot
+//   cyl 17 sec 2-9     directory, eight 32-byte FPDEs per sector
+//
+// A granule is 5 sectors (2 per cylinder).  An entry's Directory Entry Code
+// (DEC) is its HIT offset: entry-in-sector * 32 + (sector - 2).
+//
+// Writes land in a sector overlay, so the DOS always reads back what it
+// wrote, and are then propagated to the host:
+//   - data sectors of a mapped file are written through to the host file;
+//   - a directory sector write re-reads the FPDEs: new entries create host
+//     files, grown/shrunk entries are rewritten to their ERN/EOF size, and
+//     renamed entries rename the host file.
+// KILL is deliberately not propagated — the host file is only unmapped.
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class HostDirDisk {
+public:
+    static constexpr int TRACKS        = 40;
+    static constexpr int SECTORS       = 10;
+    static constexpr int SECTOR_BYTES  = 256;
+    static constexpr int DIR_TRACK     = 17;
+    static constexpr int GRAN_SECTORS  = 5;
+    static constexpr int GRANS_PER_CYL = SECTORS / GRAN_SECTORS;
+
+    // Scan dir and build the allocation plan.  False if dir is unreadable.
+    bool mount(const std::string& dir);
+
+    // 256-byte sector contents, or nullptr if out of range.  The pointer is
+    // valid until the next call.
+    const uint8_t* read_sector(int track, int sector);
+    bool write_sector(int track, int sector, const uint8_t* data);
+
+    const std::string& path() const { return dir_; }
+    size_t file_count() const { return files_.size(); }
+    size_t overlay_bytes() const { return overlay_.size() * SECTOR_BYTES; }
+
+private:
+    struct Extent {
+        int gran  = 0;   // first granule (cylinder * 2 + granule-in-cylinder)
+        int count = 0;   // contiguous granules
+        bool operator==(const Extent&) const = default;
+    };
+    struct File {
+        std::string host_name;     // file name inside dir_
+        std::string name11;        // LDOS NAME+EXT, space padded
+        uint32_t    size = 0;
+        std::vector<Extent> extents;
+        int         dec  = 0;
+    };
+
+    std::string dir_;
+    std::vector<File> files_;
+    // Per absolute sector (track * 10 + sector): owning file or -1, and the
+    // byte offset of the sector within that file.
+    std::vector<int>      owner_;
+    std::vector<uint32_t> owner_off_;
+    std::unordered_map<uint32_t, std::array<uint8_t, SECTOR_BYTES>> overlay_;
+    std::array<uint8_t, SECTOR_BYTES> scratch_{};
+    std::string disk_name_, disk_date_;
+
+    void rebuild_owners();
+    void build_system_sector(int track, int sector, uint8_t* out) const;
+    void read_file_sector(const File& f, uint32_t offset, uint8_t* out) const;
+    void sync_directory();
+    std::string host_path(const std::string& name) const;
+    std::vector<uint8_t> gather(const std::vector<Extent>& extents, uint32_t size);
+
+    static uint8_t name_hash(const std::string& name11);
+    static std::string ldos_name(const std::string& host_name);
+    static std::string host_name_for(const std::string& name11);
+};
@@ -0,0 +1,102 @@
+// src/fdc/ImageCache.cpp
+// Shared disk image cache — see ImageCache.hpp.
+#include "ImageCache.hpp"
+#include "../system/Fnv1a.hpp"
+#include "../system/ZipReader.hpp"
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PathStamp {
+    uintmax_t size = 0;
+    fs::file_time_type mtime{};
+    std::weak_ptr<const std::vector<uint8_t>> bytes;
+};
+
+std::mutex g_mutex;
+// Content hash → images with that hash (a vector only to survive collisions).
+std::unordered_map<uint64_t, std::vector<std::weak_ptr<const std::vector<uint8_t>>>> g_by_hash;
+std::unordered_map<std::string, PathStamp> g_by_path;
+uint64_t g_hits   = 0;
+uint64_t g_misses = 0;
+
+// Caller holds g_mutex.
+ImageCache::Bytes intern_locked(std::vector<uint8_t>&& bytes) {
+    auto& bucket = g_by_hash[ImageCache::hash(bytes)];
+    for (auto it = bucket.begin(); it != bucket.end(); ) {
+        if (auto live = it->lock()) {
+            if (*live == bytes) { g_hits++; return live; }
+            ++it;
+        } else {
+            it = bucket.erase(it);   // image freed since it was cached
+        }
+    }
+    g_misses++;
+    auto shared = std::make_shared<const std::vector<uint8_t>>(std::move(bytes));
+    bucket.push_back(shared);
+    return shared;
+}
+
+} // namespace
+
+uint64_t ImageCache::hash(const std::vector<uint8_t>& bytes) {
+    return fnv1a(bytes.data(), bytes.size());
+}
+
+ImageCache::Bytes ImageCache::intern(std::vector<uint8_t> bytes) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    return intern_locked(std::move(bytes));
+}
+
+ImageCache::Bytes ImageCache::load_file(const std::string& path,
+                                        const std::vector<std::string>& zip_exts) {
+    auto src = ZipReader::resolve(path, zip_exts);
+    if (!src) return nullptr;
+    const std::string& file = src->from_zip() ? src->zip : src->entry;
+
+    std::error_code ec;
+    fs::path p = fs::weakly_canonical(fs::path(file), ec);
+    std::string key = ec ? file : p.string();
+    if (src->from_zip()) key += "!" + src->entry;
+    uintmax_t size = fs::file_size(file, ec);
+    if (ec) return nullptr;
+    auto mtime = fs::last_write_time(file, ec);
+    if (ec) return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        auto it = g_by_path.find(key);
+        if (it != g_by_path.end() && it->second.size == size && it->second.mtime == mtime) {
+            if (auto live = it->second.bytes.lock()) { g_hits++; return live; }
+        }
+    }
+
+    // Read outside the lock; another thread may race us, intern() dedupes.
+    std::vector<uint8_t> bytes;
+    if (!ZipReader::read(*src, bytes)) return nullptr;
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Bytes shared = intern_locked(std::move(bytes));
+    g_by_path[key] = PathStamp{size, mtime, shared};
+    return shared;
+}
+
+ImageCache::Stats ImageCache::stats() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Stats s;
+    for (const auto& [h, bucket] : g_by_hash) {
+        for (const auto& w : bucket) {
+            if (auto live = w.lock()) {
+                s.images++;
+                s.bytes += live->size();
+            }
+        }
+    }
+    s.hits   = g_hits;
+    s.misses = g_misses;
+    return s;
+}
@@ -0,0 +1,43 @@
+// src/fdc/ImageCache.hpp
+// Process-wide cache of immutable disk image bytes.
+//
+// Every machine that mounts the same system disk (ld1-531.dsk, a games disk,
+// ...) gets a reference to one shared, read-only copy of its bytes.  Entries
+// are keyed by content hash and reference-counted: the cache only holds weak
+// references, so an image is freed when the last drive using it lets go.
+// Writes never touch the shared bytes — DiskImage keeps a per-instance
+// overlay of the sectors it has modified.
+//
+// A second index keyed by (path, size, mtime) lets repeat mounts of an
+// unchanged file skip reading it at all.  Paths are zip-transparent (see
+// ZipReader); for a zip entry the stamp is the archive's, so an unchanged
+// archive is not inflated twice.  All entry points are thread-safe.
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ImageCache {
+public:
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    // Read a file through the cache.  Returns nullptr if it cannot be read.
+    // `zip_exts` picks the entry when `path` is a bare .zip.
+    static Bytes load_file(const std::string& path,
+                           const std::vector<std::string>& zip_exts = {});
+
+    // Share bytes already in memory (identical content → same buffer).
+    static Bytes intern(std::vector<uint8_t> bytes);
+
+    struct Stats {
+        size_t   images = 0;   // distinct live images
+        size_t   bytes  = 0;   // bytes held by live images
+        uint64_t hits   = 0;   // mounts served from an existing image
+        uint64_t misses = 0;   // mounts that created a new image
+    };
+    static Stats stats();
+
+    // 64-bit FNV-1a over the image bytes.
+    static uint64_t hash(const std::vector<uint8_t>& bytes);
+};
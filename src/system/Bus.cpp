@@ -1,5 +1,7 @@
 // src/system/Bus.cpp
 #include "Bus.hpp"
+#include "ZipReader.hpp"
+#include "BusStats.hpp"
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
@@ -25,11 +27,14 @@ void Bus::reset() {
     ram.fill(0x00);
     rom_shadow_.fill(0x00);
     rom_shadow_active_.fill(false);
+    rom_page_shadowed_.fill(false);
     global_t_states = 0;
+    fdc_.reset_clock();
     last_type1_t_   = 0;
     fdc_type1_idle_ = false;
     current_scanline = 0;
     t_states_in_scanline = 0;
+    wait_states_ = 0;
     int_pending = false;
     int_for_latch = false;
     iff_enabled = true;
@@ -46,11 +51,14 @@ void Bus::soft_reset() {
     vram.fill(0x20);
     rom_shadow_.fill(0x00);
     rom_shadow_active_.fill(false);
+    rom_page_shadowed_.fill(false);
     global_t_states = 0;
+    fdc_.reset_clock();
     last_type1_t_   = 0;
     fdc_type1_idle_ = false;
     current_scanline = 0;
     t_states_in_scanline = 0;
+    wait_states_ = 0;
     int_pending = false;
     int_for_latch = false;
     iff_enabled = true;
@@ -73,6 +81,52 @@ void Bus::hard_reset() {
     ram.fill(0x00);
 }
 
+// ============================================================================
+// SNAPSHOT
+// ============================================================================
+void Bus::save_state(State& s) const {
+    s.vram = vram;
+    s.ram  = ram;
+    s.rom_shadow        = rom_shadow_;
+    s.rom_shadow_active = rom_shadow_active_;
+    s.global_t_states      = global_t_states;
+    s.last_type1_t         = last_type1_t_;
+    s.fdc_type1_idle       = fdc_type1_idle_;
+    s.current_scanline     = current_scanline;
+    s.t_states_in_scanline = t_states_in_scanline;
+    s.wait_states          = wait_states_;
+    s.int_pending          = int_pending;
+    s.int_for_latch        = int_for_latch;
+    s.cas_prev_port_val    = cas_prev_port_val;
+    s.cas_last_activity_t  = cas_last_activity_t;
+    fdc_.save_state(s.fdc);
+}
+
+void Bus::load_state(const State& s) {
+    vram = s.vram;
+    ram  = s.ram;
+    rom_shadow_        = s.rom_shadow;
+    rom_shadow_active_ = s.rom_shadow_active;
+    sync_rom_pages();
+    global_t_states      = s.global_t_states;
+    last_type1_t_        = s.last_type1_t;
+    fdc_type1_idle_      = s.fdc_type1_idle;
+    current_scanline     = s.current_scanline;
+    t_states_in_scanline = s.t_states_in_scanline;
+    wait_states_         = s.wait_states;
+    int_pending          = s.int_pending;
+    int_for_latch        = s.int_for_latch;
+    cas_prev_port_val    = s.cas_prev_port_val;
+    cas_last_activity_t  = s.cas_last_activity_t;
+    fdc_.load_state(s.fdc);
+}
+
+void Bus::sync_rom_pages() {
+    rom_page_shadowed_.fill(false);
+    for (uint16_t a = 0; a <= ROM_END; a++)
+        if (rom_shadow_active_[a]) rom_page_shadowed_[a >> 8] = true;
+}
+
 void Bus::load_rom(const std::string& path, uint16_t offset) {
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
@@ -91,10 +145,19 @@ void Bus::load_rom(const std::string& path, uint16_t offset) {
     std::cout << "Loaded ROM: " << path << " (" << size << " bytes)" << std::endl;
 }
 
+void Bus::load_rom(const uint8_t* data, size_t size, uint16_t offset) {
+    if (offset + size > ROM_SIZE) {
+        throw std::runtime_error("ROM too large for memory map");
+    }
+    std::copy(data, data + size, rom.begin() + offset);
+}
+
 // ============================================================================
 // MEMORY READ (With TRS-80 Video Contention)
 // ============================================================================
 uint8_t Bus::read(uint16_t addr, bool is_m1) {
+    if (stats_) stats_->on_read(addr, is_m1);
+
     // Flat memory mode: simple 64KB RAM
     if (flat_mode) {
         return flat_mem[addr];
@@ -102,9 +165,9 @@ uint8_t Bus::read(uint16_t addr, bool is_m1) {
 
     // Check for video bus contention (TRS-80 Model I specific)
     if (should_insert_wait_state(addr, is_m1)) {
-        // Insert 2 wait states during M1 cycle on visible scanlines
-        global_t_states += 2;
-        update_video_timing(2);
+        // Insert 2 wait states during M1 cycle on visible scanlines.  They
+        // reach the clocks through the CPU's T-state count (take_wait_states).
+        wait_states_ += 2;
     }
 
     uint8_t value = 0x00;
@@ -171,12 +234,14 @@ uint8_t Bus::read(uint16_t addr, bool is_m1) {
             // paper, but the three loops are wait-LOW / wait-HIGH / wait-LOW.  With
             // phase reset at seek, elapsed=0 → HIGH; wait-LOW ≤ 17,740 + wait-HIGH ≤
             // 337,060 + wait-LOW ≤ 17,740 = 372,540 T < 589,960. ✓
+            //
+            // ACCURATE FDC timing derives INDEX from the disk's real rotation
+            // inside FDC::read(), so this approximation is zero-latency only.
             if (addr == 0x37EC && fdc_type1_idle_
+                    && fdc_.timing() == FDC::Timing::ZERO_LATENCY
                     && (value == 0x00 || value == 0x04 /* ST_TRACK0 */)) {
-                constexpr uint64_t INDEX_PERIOD = 354800;  // T-states / revolution (300 RPM)
-                constexpr uint64_t INDEX_WIDTH  =  17740;  // 5% duty ≈ 1 ms at 1.774 MHz
                 uint64_t elapsed = global_t_states - last_type1_t_;
-                if ((elapsed % INDEX_PERIOD) < INDEX_WIDTH)
+                if ((elapsed % FDC::T_PER_REV) < FDC::T_INDEX_WIDTH)
                     value |= 0x02;  // bit 1 = INDEX PULSE in Type I idle
             }
         }
@@ -197,6 +262,9 @@ uint8_t Bus::read(uint16_t addr, bool is_m1) {
 // MEMORY WRITE
 // ============================================================================
 void Bus::write(uint16_t addr, uint8_t val) {
+    if (writes_) writes_->on_write(addr);
+    if (stats_) stats_->on_write(addr);
+
     // Flat memory mode: simple 64KB RAM
     if (flat_mode) {
         flat_mem[addr] = val;
@@ -208,6 +276,7 @@ void Bus::write(uint16_t addr, uint8_t val) {
         // LDOS installs its interrupt handler at 0x0038 this way.
         rom_shadow_[addr]        = val;
         rom_shadow_active_[addr] = true;
+        rom_page_shadowed_[addr >> 8] = true;
         return;
     } else if (addr >= 0x37E0 && addr <= 0x37EF) {
         // Disk controller registers (expansion interface)
@@ -246,6 +315,7 @@ bool Bus::load_disk(int drive, const std::string& path) {
 void Bus::add_ticks(int t) {
     global_t_states += t;
     update_video_timing(t);
+    fdc_.advance(global_t_states);   // rotational clock (ACCURATE timing)
 }
 
 // ============================================================================
@@ -254,8 +324,10 @@ void Bus::add_ticks(int t) {
 void Bus::update_video_timing(int t_states) {
     t_states_in_scanline += t_states;
 
-    // Check if we've completed this scanline
-    if (t_states_in_scanline >= VIDEO_T_STATES_PER_SCANLINE) {
+    // Check if we've completed this scanline.  Loop rather than test once:
+    // host-side fast paths (FastDisk, KeyInjector) may charge many scanlines'
+    // worth of T-states in a single add_ticks() call.
+    while (t_states_in_scanline >= VIDEO_T_STATES_PER_SCANLINE) {
         t_states_in_scanline -= VIDEO_T_STATES_PER_SCANLINE;
         current_scanline++;
 
@@ -298,7 +370,7 @@ bool Bus::should_insert_wait_state(uint16_t addr, bool is_m1) const {
     }
 
     // Contention happens during specific T-states in the scanline
-    uint16_t t_in_line = t_states_in_scanline % VIDEO_T_STATES_PER_SCANLINE;
+    uint16_t t_in_line = (t_states_in_scanline + wait_states_) % VIDEO_T_STATES_PER_SCANLINE;
 
     // Video contention window (approximate)
     constexpr uint16_t CONTENTION_START = 30;
@@ -327,6 +399,7 @@ uint8_t Bus::get_vram_byte(uint16_t vram_addr) const {
 // PORT I/O (Cassette & Other)
 // ============================================================================
 uint8_t Bus::read_port(uint8_t port) {
+    if (stats_) stats_->on_in(port);
     if (port == 0xFF) {
         uint8_t val = cas_prev_port_val & 0x7F;  // Echo current output bits
         // Bit 7: cassette data input (FSK signal during playback)
@@ -340,6 +413,7 @@ uint8_t Bus::read_port(uint8_t port) {
 }
 
 void Bus::write_port(uint8_t port, uint8_t val) {
+    if (stats_) stats_->on_out(port);
     if (port == 0xFF) {
         on_cassette_write(val);
         cas_prev_port_val = val;
@@ -525,17 +599,13 @@ void Bus::record_bit(bool bit) {
 // CASSETTE FILE I/O
 // ============================================================================
 bool Bus::load_cas_file(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.is_open()) {
+    // Zip-transparent: inflates straight into cas_data.
+    if (!ZipReader::read(path, cas_data, {".cas"})) {
         std::cerr << "Cassette: Cannot open " << path << std::endl;
+        cas_data.clear();
         return false;
     }
-    file.seekg(0, std::ios::end);
-    size_t size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    cas_data.resize(size);
-    file.read(reinterpret_cast<char*>(cas_data.data()), size);
+    size_t size = cas_data.size();
 
     std::cout << "Cassette: Loaded " << path << " (" << size << " bytes)" << std::endl;
     return true;
@@ -579,6 +649,12 @@ void Bus::start_recording() {
     cas_last_activity_t = global_t_states;
 }
 
+void Bus::record_byte(uint8_t b) {
+    if (cas_state != CassetteState::RECORDING) return;
+    cas_rec_data.push_back(b);
+    cas_last_activity_t = global_t_states;
+}
+
 void Bus::stop_cassette() {
     if (cas_state == CassetteState::RECORDING) {
         flush_recording();
@@ -6,6 +6,8 @@
 #include <vector>
 #include "../fdc/FDC.hpp"
 
+class BusStats;
+
 // ============================================================================
 // TRS-80 MODEL I MEMORY MAP
 // ============================================================================
@@ -58,12 +60,17 @@ public:
     uint8_t read(uint16_t addr, bool is_m1 = false);
     void write(uint16_t addr, uint8_t val);
     void add_ticks(int t);
+    // Wait states inserted by read() since the last call.  Z80::step() adds
+    // them to the instruction's T-states, so every clock (frame budget,
+    // global_t_states, FDC, sound) advances by the same amount.
+    int take_wait_states() { int w = wait_states_; wait_states_ = 0; return w; }
 
     // System Interface (called from Main Loop)
     void reset();       // Power-on init (called from constructor; clears ROM+RAM)
     void soft_reset();  // Soft reset: clears VRAM/cassette/state, preserves ROM+RAM
     void hard_reset();  // Hard reset: soft_reset + clears RAM (simulates power cycle)
     void load_rom(const std::string& path, uint16_t offset = ROM_START);
+    void load_rom(const uint8_t* data, size_t size, uint16_t offset = ROM_START);
     void trigger_interrupt();
     bool interrupt_pending() const { return int_pending || fdc_.intrq_pending(); }
     void clear_interrupt() { int_pending = false; }  // clears timer; FDC INTRQ clears on status read
@@ -86,12 +93,16 @@ public:
     bool load_disk(int drive, const std::string& path);
     bool fdc_present() const { return fdc_.is_present(); }
     std::string get_disk_name(int drive) const { return fdc_.get_disk_name(drive); }
+    // Direct controller access for host-side fast paths (FastDisk).
+    FDC& fdc() { return fdc_; }
 
     // Cassette File Operations
     bool load_cas_file(const std::string& path);
     bool save_cas_file(const std::string& path);
     void start_playback();
     void start_recording();
+    // Append a whole byte to the recording (fast CSAVE, no FSK decode).
+    void record_byte(uint8_t b);
     void stop_cassette();
     CassetteState get_cassette_state() const { return cas_state; }
     void set_cas_filename(const std::string& name) { cas_filename = name; }
@@ -114,6 +125,14 @@ public:
     // CPU PC tracking for watchpoints (call before cpu_.step())
     void set_cpu_pc(uint16_t pc) { last_cpu_pc_ = pc; }
 
+    // Access counters (--bus-stats, BusStats.hpp).  nullptr = off.
+    void set_stats(BusStats* stats) { stats_ = stats; }
+    BusStats* stats() const { return stats_; }
+
+    // Write tracking (--rewind, WriteLog below).  nullptr = off.
+    struct WriteLog;
+    void set_write_log(WriteLog* log) { writes_ = log; }
+
     // Memory Access for Debugging
     const std::array<uint8_t, ROM_SIZE>& get_rom() const { return rom; }
     const std::array<uint8_t, RAM_SIZE>& get_ram() const { return ram; }
@@ -135,6 +154,8 @@ private:
     // CPU PC TRACKING (for watchpoint logging in write())
     // =========================================================================
     uint16_t last_cpu_pc_ = 0;
+    BusStats* stats_ = nullptr;
+    WriteLog* writes_ = nullptr;
 
     // =========================================================================
     // TIMING & STATE
@@ -145,7 +166,8 @@ private:
     bool     fdc_type1_idle_ = false;   // True after Type I cmd, false after Type II+
                                         // Prevents DRQ-bit corruption during sector reads
     uint16_t current_scanline = 0;      // Current video scanline (0-261)
-    uint16_t t_states_in_scanline = 0;  // T-states within current scanline
+    uint32_t t_states_in_scanline = 0;  // T-states within current scanline
+    int      wait_states_ = 0;          // Contention owed, not yet charged via add_ticks()
     bool int_pending = false;           // Interrupt pending flag (cleared on delivery)
     bool int_for_latch = false;         // Disk-expansion latch bit (cleared by reading 0x37E0)
     bool iff_enabled = true;            // Interrupts enabled (simplified)
@@ -196,6 +218,10 @@ private:
     // area (0x0000-0x2FFF) is stored here, and reads prefer it over ROM.
     std::array<uint8_t, ROM_SIZE> rom_shadow_{};
     std::array<bool, ROM_SIZE>    rom_shadow_active_{};
+    // Per 256-byte page: any byte shadowed.  One extra entry so the page
+    // after 0x2FFF can be looked up; it is never set.
+    std::array<bool, ROM_SIZE / 256 + 1> rom_page_shadowed_{};
+    void sync_rom_pages();
 
     // =========================================================================
     // DISK CONTROLLER
@@ -213,4 +239,53 @@ public:
     uint8_t* get_flat_memory() { return flat_mem.data(); }
     bool is_flat_mode() const { return flat_mode; }
 
+    // True if reads of addr..addr+2 (addr <= ROM_END) return the ROM image:
+    // no byte in their pages has been shadowed.  Gates translated ROM code.
+    bool rom_unshadowed(uint16_t addr) const {
+        return !flat_mode && !rom_page_shadowed_[addr >> 8] &&
+               !rom_page_shadowed_[(addr + 2) >> 8];
+    }
+
+    // =========================================================================
+    // WRITE TRACKING (--rewind)
+    // =========================================================================
+    using AddrBits = std::array<uint64_t, 65536 / 64>;
+    struct WriteLog {
+        // Bit per address written since the owner last cleared it, over the
+        // whole address space including the ignored ROM/keyboard ranges.
+        AddrBits written{};
+        // Set when `watch` (-1 = none) is written.
+        int      watch     = -1;
+        bool     watch_hit = false;
+
+        void on_write(uint16_t addr) {
+            written[addr >> 6] |= 1ull << (addr & 63);
+            if (addr == watch) watch_hit = true;
+        }
+    };
+
+    // =========================================================================
+    // SNAPSHOT (run-ahead)
+    // =========================================================================
+    // Memory, video/interrupt timing and the disk controller — everything a
+    // frame of emulation changes while the cassette is idle.  Tape buffers
+    // and the ROM image are not copied.  About 75KB, a handful of memcpy()s.
+    struct State {
+        std::array<uint8_t, VRAM_SIZE> vram;
+        std::array<uint8_t, RAM_SIZE>  ram;
+        std::array<uint8_t, ROM_SIZE>  rom_shadow;
+        std::array<bool, ROM_SIZE>     rom_shadow_active;
+        uint64_t global_t_states, last_type1_t;
+        bool     fdc_type1_idle;
+        uint16_t current_scanline;
+        uint32_t t_states_in_scanline;
+        int      wait_states;
+        bool     int_pending, int_for_latch;
+        uint8_t  cas_prev_port_val;
+        uint64_t cas_last_activity_t;
+        FDC::State fdc;
+    };
+    void save_state(State& s) const;
+    void load_state(const State& s);
+
 };
\ No newline at end of file
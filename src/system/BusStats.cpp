@@ -0,0 +1,113 @@
+// src/system/BusStats.cpp
+// Memory and I/O access counters — see BusStats.hpp.
+#include "BusStats.hpp"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+const char* const DEVICE_NAMES[BusStats::DEVICES] = {
+    "kbd_read",
+    "vram_read", "vram_write",
+    "latch_read",
+    "drive_select",
+    "printer_read", "printer_write",
+    "fdc_status_read", "fdc_command",
+    "fdc_track_read", "fdc_track_write",
+    "fdc_sector_read", "fdc_sector_write",
+    "fdc_data_read", "fdc_data_write",
+    "port_ff_in", "port_ff_out",
+    "port_other_in", "port_other_out",
+};
+
+void write_pages(FILE* f, const char* name, const std::array<uint64_t, 256>& pages) {
+    std::fprintf(f, "\"%s\":[", name);
+    for (int p = 0; p < 256; p++)
+        std::fprintf(f, "%s%llu", p ? "," : "", static_cast<unsigned long long>(pages[p]));
+    std::fprintf(f, "]");
+}
+}  // namespace
+
+const char* BusStats::device_name(int d) { return DEVICE_NAMES[d]; }
+
+void BusStats::Counts::add(const Counts& o) {
+    for (int p = 0; p < 256; p++) {
+        fetch[p] += o.fetch[p];
+        read[p]  += o.read[p];
+        write[p] += o.write[p];
+    }
+    for (int d = 0; d < DEVICES; d++) io[d] += o.io[d];
+    t_states += o.t_states;
+}
+
+// ============================================================================
+// WINDOWS
+// ============================================================================
+bool BusStats::open(const std::string& path, int frames) {
+    close();
+    out_ = std::fopen(path.c_str(), "w");
+    if (!out_) return false;
+    path_ = path;
+    window_t_ = static_cast<uint64_t>(std::max(frames, 1)) * T_PER_FRAME;
+    cur_ = total_ = Counts{};
+    window_ = t_ = 0;
+    return true;
+}
+
+void BusStats::end_frame(uint64_t t_states) {
+    cur_.t_states += t_states;
+    t_ += t_states;
+    if (cur_.t_states >= window_t_) flush_window();
+}
+
+void BusStats::flush_window() {
+    if (!out_ || !cur_.t_states) return;
+    std::fprintf(out_, "{\"window\":%llu,\"frame\":%llu,\"t_states\":%llu,",
+                 static_cast<unsigned long long>(window_),
+                 static_cast<unsigned long long>((t_ - cur_.t_states) / T_PER_FRAME),
+                 static_cast<unsigned long long>(cur_.t_states));
+    write_pages(out_, "fetch", cur_.fetch);
+    std::fputc(',', out_);
+    write_pages(out_, "read", cur_.read);
+    std::fputc(',', out_);
+    write_pages(out_, "write", cur_.write);
+    std::fprintf(out_, ",\"io\":{");
+    for (int d = 0; d < DEVICES; d++)
+        std::fprintf(out_, "%s\"%s\":%llu", d ? "," : "", DEVICE_NAMES[d],
+                     static_cast<unsigned long long>(cur_.io[d]));
+    std::fprintf(out_, "}}\n");
+
+    total_.add(cur_);
+    cur_ = Counts{};
+    window_++;
+}
+
+void BusStats::close() {
+    if (!out_) return;
+    flush_window();
+    std::fclose(out_);
+    out_ = nullptr;
+    print_totals();
+}
+
+// Busiest pages and every device touched, per emulated second.
+void BusStats::print_totals() const {
+    if (!total_.t_states) return;
+    double secs = static_cast<double>(total_.t_states) / (T_PER_FRAME * 60);
+    std::fprintf(stderr, "[STATS] %.1f emulated seconds in %llu windows written to %s\n", secs,
+                 static_cast<unsigned long long>(window_), path_.c_str());
+
+    std::vector<int> pages(256);
+    std::iota(pages.begin(), pages.end(), 0);
+    auto sum = [&](int p) { return total_.fetch[p] + total_.read[p] + total_.write[p]; };
+    std::sort(pages.begin(), pages.end(), [&](int a, int b) { return sum(a) > sum(b); });
+    for (int i = 0; i < 8 && sum(pages[i]); i++) {
+        int p = pages[i];
+        std::fprintf(stderr, "[STATS] page %02X00: %10.0f fetch %10.0f read %10.0f write /s\n", p,
+                     total_.fetch[p] / secs, total_.read[p] / secs, total_.write[p] / secs);
+    }
+    for (int d = 0; d < DEVICES; d++) {
+        if (!total_.io[d]) continue;
+        std::fprintf(stderr, "[STATS] %-17s %10.0f /s\n", DEVICE_NAMES[d], total_.io[d] / secs);
+    }
+}
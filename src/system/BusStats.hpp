@@ -0,0 +1,115 @@
+// src/system/BusStats.hpp
+// Memory and I/O access counters (--bus-stats <file>).
+//
+// While attached to the Bus (Bus::set_stats), every read, write, M1 opcode
+// fetch and port access is counted: per 256-byte page, and per memory-mapped
+// device register.  The counts show where the emulated software spends its
+// bus cycles — DRQ polling loops on the FDC data register, keyboard scans,
+// 0x37E0 latch reads in the ISR — so host-side fast paths go where they pay.
+//
+// Counts accumulate over a window of emulated time (default 60 frames, one
+// second), closed at the first frame boundary past it — at unlimited speed
+// a "frame" of the loop is several.  Each window appends one JSON line to
+// the output file; "frame" is where it starts, in 60 Hz frames:
+//
+//   {"window":0,"frame":0,"t_states":1769880,
+//    "fetch":[256 counts],"read":[256],"write":[256],
+//    "io":{"kbd_read":1234,"fdc_data_read":0,...}}
+//
+// "read" excludes M1 fetches, which are in "fetch".  Each row of a heatmap
+// is a window and each column a page; tools/bus_heatmap.py draws one.  The
+// run's totals are printed on exit.
+//
+// Only the Bus calls on_*(); off (no BusStats attached) it costs one test
+// per access.  Opcode bytes the translated ROM compiles in never reach the
+// Bus, so the emulator interprets the ROM while counting.
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+class BusStats {
+public:
+    static constexpr uint64_t T_PER_FRAME = 29498;   // 60 Hz
+
+    // Memory-mapped devices and ports, in output order.
+    enum Device {
+        KBD_READ,                        // 0x3800-0x3BFF
+        VRAM_READ, VRAM_WRITE,           // 0x3C00-0x3FFF
+        LATCH_READ,                      // 0x37E0-0x37E3: interrupt latch
+        DRIVE_SELECT,                    // 0x37E0-0x37E3 written
+        PRINTER_READ, PRINTER_WRITE,     // 0x37E8-0x37EB
+        FDC_STATUS_READ, FDC_COMMAND,    // 0x37EC
+        FDC_TRACK_READ, FDC_TRACK_WRITE, // 0x37ED
+        FDC_SECTOR_READ, FDC_SECTOR_WRITE, // 0x37EE
+        FDC_DATA_READ, FDC_DATA_WRITE,   // 0x37EF
+        PORT_FF_IN, PORT_FF_OUT,         // cassette / sound
+        PORT_OTHER_IN, PORT_OTHER_OUT,
+        DEVICES
+    };
+    static const char* device_name(int d);
+
+    struct Counts {
+        std::array<uint64_t, 256>     fetch{}, read{}, write{};
+        std::array<uint64_t, DEVICES> io{};
+        uint64_t t_states = 0;
+        void add(const Counts& o);
+    };
+
+    ~BusStats() { close(); }
+
+    // Start writing windows of `frames` frames to `path`.  False if the file
+    // cannot be created.
+    bool open(const std::string& path, int frames);
+    // Write the partial window, print the totals and close the file.
+    void close();
+    bool is_open() const { return out_ != nullptr; }
+
+    // From the emulator after each real (not run-ahead) pass of its frame
+    // loop, with the T-states it ran.
+    void end_frame(uint64_t t_states);
+
+    const Counts& totals() const { return total_; }
+
+    // ---- From the Bus --------------------------------------------------
+    void on_read(uint16_t addr, bool is_m1) {
+        (is_m1 ? cur_.fetch : cur_.read)[addr >> 8]++;
+        if (addr >= 0x37E0 && addr <= 0x3FFF) device_read(addr);
+    }
+    void on_write(uint16_t addr) {
+        cur_.write[addr >> 8]++;
+        if (addr >= 0x37E0 && addr <= 0x3FFF) device_write(addr);
+    }
+    void on_in(uint8_t port)  { cur_.io[port == 0xFF ? PORT_FF_IN  : PORT_OTHER_IN]++; }
+    void on_out(uint8_t port) { cur_.io[port == 0xFF ? PORT_FF_OUT : PORT_OTHER_OUT]++; }
+
+private:
+    Counts   cur_;      // this window
+    Counts   total_;
+    FILE*    out_ = nullptr;
+    std::string path_;
+    uint64_t window_t_ = 60 * T_PER_FRAME;
+    uint64_t window_ = 0, t_ = 0;   // windows written, T-states so far
+
+    // 0x37E0-0x3FFF, decoded as in Bus::read/write.  Inline, so the Bus
+    // needs nothing from BusStats.cpp.
+    void device_read(uint16_t addr) {
+        if (addr >= 0x3C00)      cur_.io[VRAM_READ]++;
+        else if (addr >= 0x3800) cur_.io[KBD_READ]++;
+        else if (addr <= 0x37E3) cur_.io[LATCH_READ]++;
+        else if (addr <= 0x37E7) {}
+        else if (addr <= 0x37EB) cur_.io[PRINTER_READ]++;
+        else                     cur_.io[FDC_STATUS_READ + (addr - 0x37EC) * 2]++;
+    }
+    void device_write(uint16_t addr) {
+        if (addr >= 0x3C00)      cur_.io[VRAM_WRITE]++;
+        else if (addr >= 0x3800) {}
+        else if (addr <= 0x37E3) cur_.io[DRIVE_SELECT]++;
+        else if (addr <= 0x37E7) {}
+        else if (addr <= 0x37EB) cur_.io[PRINTER_WRITE]++;
+        else                     cur_.io[FDC_COMMAND + (addr - 0x37EC) * 2]++;
+    }
+    void flush_window();
+    void print_totals() const;
+};
@@ -0,0 +1,18 @@
+// src/system/Fnv1a.hpp
+// 64-bit FNV-1a: the content hash behind the image cache, the boot cache
+// key, the translated-ROM check and divergence_bisect's state compare.
+// Header-only, so none of them links anything for it.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint64_t FNV1A_BASIS = 0xCBF29CE484222325ull;
+constexpr uint64_t FNV1A_PRIME = 0x100000001B3ull;
+
+// Hash `n` bytes at `data`, continuing from `h` (chain calls to hash
+// several buffers as one).
+inline uint64_t fnv1a(const void* data, size_t n, uint64_t h = FNV1A_BASIS) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < n; i++) { h ^= p[i]; h *= FNV1A_PRIME; }
+    return h;
+}
@@ -0,0 +1,133 @@
+// src/system/ZipReader.cpp
+// Zip-transparent file reading — see ZipReader.hpp.
+#include "ZipReader.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+extern "C" {
+// Suppress unused-function warnings from miniz's inline zlib-compat wrappers
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"
+#include "../miniz.h"
+#pragma clang diagnostic pop
+}
+
+namespace fs = std::filesystem;
+
+static std::string to_lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+static bool is_zip(const fs::path& p) {
+    return to_lower(p.extension().string()) == ".zip";
+}
+
+// Index of the entry named `name` (case-insensitive), or -1.
+static int find_entry(mz_zip_archive& zip, const std::string& name) {
+    std::string want = to_lower(name);
+    mz_uint n = mz_zip_reader_get_num_files(&zip);
+    for (mz_uint i = 0; i < n; i++) {
+        mz_zip_archive_file_stat st;
+        if (!mz_zip_reader_file_stat(&zip, i, &st) || st.m_is_directory) continue;
+        if (to_lower(st.m_filename) == want) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+std::vector<std::string> ZipReader::list(const std::string& zip_path) {
+    std::vector<std::string> names;
+    mz_zip_archive zip{};
+    if (!mz_zip_reader_init_file(&zip, zip_path.c_str(), 0)) return names;
+    mz_uint n = mz_zip_reader_get_num_files(&zip);
+    for (mz_uint i = 0; i < n; i++) {
+        mz_zip_archive_file_stat st;
+        if (mz_zip_reader_file_stat(&zip, i, &st) && !st.m_is_directory)
+            names.push_back(st.m_filename);
+    }
+    mz_zip_reader_end(&zip);
+    return names;
+}
+
+std::optional<ZipReader::Source> ZipReader::resolve(const std::string& path,
+                                                    const std::vector<std::string>& exts) {
+    std::error_code ec;
+    fs::path p(path);
+
+    // 1. Plain, non-archive file
+    if (fs::is_regular_file(p, ec) && !is_zip(p)) return Source{"", path};
+
+    // 2. The archive itself: pick the first entry with a wanted extension
+    if (fs::is_regular_file(p, ec)) {
+        std::vector<std::string> names = list(path);
+        for (const auto& n : names) {
+            std::string ext = to_lower(fs::path(n).extension().string());
+            if (std::find(exts.begin(), exts.end(), ext) != exts.end())
+                return Source{path, n};
+        }
+        if (names.size() == 1) return Source{path, names.front()};
+        return std::nullopt;       // ambiguous or not an archive
+    }
+
+    // 3. Walk up: <prefix>.zip containing the remaining suffix
+    fs::path suffix = p.filename();
+    fs::path parent = p.parent_path();
+    while (!parent.empty() && parent != parent.parent_path()) {
+        fs::path candidate(parent.string() + ".zip");
+        if (fs::is_regular_file(candidate, ec)) {
+            mz_zip_archive zip{};
+            if (mz_zip_reader_init_file(&zip, candidate.string().c_str(), 0)) {
+                int idx = find_entry(zip, suffix.generic_string());
+                std::string name;
+                if (idx >= 0) {
+                    mz_zip_archive_file_stat st;
+                    if (mz_zip_reader_file_stat(&zip, static_cast<mz_uint>(idx), &st))
+                        name = st.m_filename;
+                }
+                mz_zip_reader_end(&zip);
+                if (!name.empty()) return Source{candidate.string(), name};
+            }
+        }
+        suffix = fs::path(parent.filename()) / suffix;
+        parent = parent.parent_path();
+    }
+    return std::nullopt;
+}
+
+bool ZipReader::read(const Source& src, std::vector<uint8_t>& out) {
+    if (!src.from_zip()) {
+        std::ifstream f(src.entry, std::ios::binary | std::ios::ate);
+        if (!f) return false;
+        out.resize(static_cast<size_t>(f.tellg()));
+        f.seekg(0);
+        f.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        return static_cast<bool>(f);
+    }
+
+    mz_zip_archive zip{};
+    if (!mz_zip_reader_init_file(&zip, src.zip.c_str(), 0)) {
+        std::cerr << "[ZIP] Cannot open archive: " << src.zip << "\n";
+        return false;
+    }
+    int idx = find_entry(zip, src.entry);
+    mz_zip_archive_file_stat st;
+    bool ok = idx >= 0 && mz_zip_reader_file_stat(&zip, static_cast<mz_uint>(idx), &st);
+    if (ok) {
+        out.resize(static_cast<size_t>(st.m_uncomp_size));
+        ok = mz_zip_reader_extract_to_mem(&zip, static_cast<mz_uint>(idx),
+                                          out.data(), out.size(), 0);
+    }
+    mz_zip_reader_end(&zip);
+    if (!ok) std::cerr << "[ZIP] Cannot extract " << src.label() << "\n";
+    return ok;
+}
+
+bool ZipReader::read(const std::string& path, std::vector<uint8_t>& out,
+                     const std::vector<std::string>& exts) {
+    auto src = resolve(path, exts);
+    return src && read(*src, out);
+}
@@ -0,0 +1,44 @@
+// src/system/ZipReader.hpp
+// Zip-transparent file reading shared by the disk, cassette and BASIC loaders.
+//
+// A path resolves, in order, to:
+//   1. an ordinary file;
+//   2. a .zip file itself — its first entry with one of the wanted
+//      extensions, else its only entry (never the archive's own bytes);
+//   3. a path through a zip, where "games/advent/start.cas" names the entry
+//      "start.cas" inside games/advent.zip.  Any number of trailing
+//      components may live in the zip; names compare case-insensitively.
+//      This is the same convention --cmd uses.
+//
+// Entries are inflated straight into the caller's buffer (sized from the
+// central directory) — no temporary files and no intermediate heap copy.
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+class ZipReader {
+public:
+    struct Source {
+        std::string zip;     // archive path; empty → plain file
+        std::string entry;   // file path, or entry name inside the archive
+
+        bool from_zip() const { return !zip.empty(); }
+        // "archive.zip!entry" or the plain path, for log messages.
+        std::string label() const { return from_zip() ? zip + "!" + entry : entry; }
+    };
+
+    // Locate `path`.  `exts` (lower-case, with dot) picks the entry when the
+    // path is a bare .zip.  nullopt if nothing matches.
+    static std::optional<Source> resolve(const std::string& path,
+                                         const std::vector<std::string>& exts = {});
+
+    // Read a resolved source / a path in full.  False on any error.
+    static bool read(const Source& src, std::vector<uint8_t>& out);
+    static bool read(const std::string& path, std::vector<uint8_t>& out,
+                     const std::vector<std::string>& exts = {});
+
+    // Entry names of an archive (directories excluded).
+    static std::vector<std::string> list(const std::string& zip);
+};
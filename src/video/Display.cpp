@@ -2,6 +2,7 @@
 #include "Display.hpp"
 #include "CharRom.hpp"
 #include "../system/Bus.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
@@ -174,18 +175,18 @@ void Display::show_overlay(int kind) {
 
     static const char* help_lines[] = {
         "Home         TRS-80 CLEAR  (Ctrl+Left on Mac)",
-        "F5           @ key  (always unshifted)",
-        "F6           0 key  (always unshifted)",
+        "F2           Performance HUD",
+        "F5 / F6      @ / 0 key  (always unshifted)",
         "F7           Dump RAM to memdump.bin",
         "F8           Quit",
-        "F9           Toggle CRT effects on/off",
-        "Shift+F9     Cycle colour  (white/amber/green)",
+        "F9 / Shift+F9  CRT on/off / cycle colour",
         "F10          Warm boot  (keeps program in RAM)",
         "Shift+F10    Hard reset  (clears RAM)",
-        "Shift+F11    This help",
+        "F11          Rewind console  (Shift+F11: this help)",
         "F12          About",
         "Ctrl+V       Paste clipboard",
         "Ctrl+0..3    Mount disk image on drive 0-3",
+        "Ctrl+- / =   Slower / faster  (0.25x .. unlimited)",
     };
 
     static const char* about_lines[] = {
@@ -311,6 +312,22 @@ void Display::build_crt_mask() {
 }
 
 void Display::update_texture() {
+    {
+        PerfHud::Scope render(hud_, PerfHud::RENDER);
+        post_process();
+    }
+    {
+        PerfHud::Scope upload(hud_, PerfHud::UPLOAD);
+        SDL_UpdateTexture(screen_texture, nullptr, post_buffer_.data(),
+                          POST_W * sizeof(uint32_t));
+    }
+    PerfHud::Scope present(hud_, PerfHud::PRESENT);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, screen_texture, nullptr, nullptr);
+    SDL_RenderPresent(renderer);
+}
+
+void Display::post_process() {
     // Nearest-neighbour 3× upscale: framebuffer (384×192) → post_buffer_ (1152×576)
     for (int py = 0; py < POST_H; py++) {
         const uint32_t* src_row = &framebuffer[(py / WINDOW_SCALE) * TRS80_WIDTH];
@@ -333,12 +350,6 @@ void Display::update_texture() {
             out[i] = (p & 0xFF000000) | (r << 16) | (g << 8) | b;
         }
     }
-
-    SDL_UpdateTexture(screen_texture, nullptr, post_buffer_.data(),
-                      POST_W * sizeof(uint32_t));
-    SDL_RenderClear(renderer);
-    SDL_RenderCopy(renderer, screen_texture, nullptr, nullptr);
-    SDL_RenderPresent(renderer);
 }
 
 void Display::render_frame(const Bus& bus) {
@@ -348,14 +359,41 @@ void Display::render_frame(const Bus& bus) {
         return;
     }
 
-    clear_screen();
-    for (int line = 0; line < TRS80_CHAR_LINES; line++)
-        for (int col = 0; col < TRS80_CHARS_PER_LINE; col++)
-            draw_character(col, line,
-                           bus.get_vram_byte(line * TRS80_CHARS_PER_LINE + col));
+    {
+        PerfHud::Scope render(hud_, PerfHud::RENDER);
+        clear_screen();
+        for (int line = 0; line < TRS80_CHAR_LINES; line++)
+            for (int col = 0; col < TRS80_CHARS_PER_LINE; col++)
+                draw_character(col, line,
+                               bus.get_vram_byte(line * TRS80_CHARS_PER_LINE + col));
+        draw_hud();
+    }
     update_texture();
 }
 
+// ============================================================================
+// PERFORMANCE HUD
+// ============================================================================
+// Drawn into the framebuffer after the screen, so it is redrawn every frame
+// and never touches VRAM.  Same colour scheme as the overlays.
+void Display::draw_hud() {
+    const std::vector<std::string>& lines = hud_.lines();
+    if (!hud_.enabled() || lines.empty()) return;
+
+    size_t cols = 0;
+    for (const std::string& l : lines) cols = std::max(cols, l.size());
+    int      next_mode = (phosphor_mode_ + 1) % 3;
+    uint32_t fg = PHOSPHOR_FG[next_mode];
+    uint32_t bg = PHOSPHOR_BG[next_mode];
+
+    int bw = static_cast<int>(cols + 2) * CHAR_CELL_W;
+    int bx = TRS80_WIDTH - bw;
+    fill_rect_fb(bx, 0, bw, static_cast<int>(lines.size()) * CHAR_CELL_H, bg);
+    for (size_t i = 0; i < lines.size(); i++)
+        draw_string_pixels(bx + CHAR_CELL_W, static_cast<int>(i) * CHAR_CELL_H,
+                           lines[i].c_str(), fg, bg);
+}
+
 void Display::render_scanline(const Bus& bus, uint16_t scanline) {
     if (scanline >= TRS80_HEIGHT) return;
     uint16_t char_line   = scanline / CHAR_CELL_H;
@@ -405,6 +443,12 @@ void Display::set_title(const std::string& title) {
     if (window) SDL_SetWindowTitle(window, title.c_str());
 }
 
+void Display::set_vsync(bool on) {
+    if (renderer && SDL_RenderSetVSync(renderer, on ? 1 : 0) != 0)
+        std::cerr << "[VIDEO] Cannot " << (on ? "enable" : "disable")
+                  << " vsync: " << SDL_GetError() << "\n";
+}
+
 // ============================================================================
 // EVENT HANDLING
 // ============================================================================
@@ -454,6 +498,13 @@ bool Display::handle_events(uint8_t* keyboard_matrix) {
                 continue;
             }
 
+            // Ctrl+- / Ctrl+=: step the speed factor down / up
+            if (ctrl && (sym == SDLK_MINUS || sym == SDLK_EQUALS)) {
+                pending_action_ = sym == SDLK_MINUS ? DisplayAction::SPEED_DOWN
+                                                    : DisplayAction::SPEED_UP;
+                continue;
+            }
+
             // F12: about overlay
             if (sym == SDLK_F12) {
                 show_overlay(2);
@@ -466,6 +517,12 @@ bool Display::handle_events(uint8_t* keyboard_matrix) {
                 continue;
             }
 
+            // F11 (unshifted): reverse-execution console
+            if (sym == SDLK_F11 && !shifted) {
+                pending_action_ = DisplayAction::REWIND;
+                continue;
+            }
+
             // F10 / Shift+F10: soft / hard reset
             if (sym == SDLK_F10) {
                 pending_action_ = shifted ? DisplayAction::HARD_RESET
@@ -473,6 +530,12 @@ bool Display::handle_events(uint8_t* keyboard_matrix) {
                 continue;
             }
 
+            // F2: performance HUD on/off
+            if (sym == SDLK_F2) {
+                hud_.set_enabled(!hud_.enabled());
+                continue;
+            }
+
             // F9 (unshifted): toggle CRT effects on/off
             if (sym == SDLK_F9 && !shifted) {
                 crt_enabled_ = !crt_enabled_;
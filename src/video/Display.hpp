@@ -1,6 +1,7 @@
 // src/video/Display.hpp
 #pragma once
 #include <SDL.h>
+#include "../PerfHud.hpp"
 #include <array>
 #include <cstdint>
 #include <string>
@@ -51,7 +52,10 @@ enum class DisplayAction {
     HARD_RESET,       // Shift+F10
     MOUNT_DISK,       // Ctrl+0..3  (drive index in pop_action drive_out)
     PASTE_CLIPBOARD,  // Ctrl+V
-    DUMP_RAM,         // F11  — dump full 64KB memory map to memdump.bin
+    DUMP_RAM,         // F7   — dump full 64KB memory map to memdump.bin
+    REWIND,           // F11  — reverse-execution console (--rewind)
+    SPEED_DOWN,       // Ctrl+-  — next slower speed factor
+    SPEED_UP,         // Ctrl+=  — next faster speed factor (up to unlimited)
 };
 
 // ============================================================================
@@ -76,6 +80,9 @@ public:
 
     void clear_screen();
     void set_title(const std::string& title);
+    // Block SDL_RenderPresent until the next vblank (--sync vsync, NORMAL
+    // speed only — turbo must not be held to the refresh rate).
+    void set_vsync(bool on);
     bool is_running() const { return running; }
 
     // Consume the oldest pending action.  drive_out is set for MOUNT_DISK.
@@ -96,6 +103,10 @@ public:
         pixel_bg_      = PHOSPHOR_BG[mode];
     }
 
+    // Performance HUD (F2).  Display times its own render / upload /
+    // present; the Emulator times the rest of its loop through it.
+    PerfHud& hud() { return hud_; }
+
 private:
     // =========================================================================
     // SDL STATE
@@ -147,6 +158,12 @@ private:
     void show_overlay(int kind);
     void hide_overlay();
 
+    // =========================================================================
+    // PERFORMANCE HUD  (F2 — top-right corner, over the screen)
+    // =========================================================================
+    PerfHud hud_;
+    void draw_hud();
+
     // =========================================================================
     // PENDING ACTION  (set by hotkey, consumed by Emulator::run)
     // =========================================================================
@@ -159,6 +176,7 @@ private:
     void draw_pixel(uint16_t x, uint16_t y, bool on);
     void draw_character(uint16_t char_x, uint16_t char_y, uint8_t char_code);
     void update_texture();
+    void post_process();     // framebuffer → post_buffer_ (upscale + CRT mask)
 
     // Overlay pixel helpers
     void fill_rect_fb(int x, int y, int w, int h, uint32_t color);
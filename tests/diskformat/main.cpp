@@ -0,0 +1,276 @@
+// tests/diskformat/main.cpp
+// Disk image format tests for Mal-80 — no ROM, no disk files needed.
+//
+// Builds small JV1, JV3 and IMD images in memory and checks that each loads
+// and serialises back byte for byte, that JV3 free header entries are sized
+// by their own code table, and that a track written through the FD1771 with
+// Write Track reads back with Read Track and Read Sector.
+//
+// Usage: disk_test
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../../src/fdc/DiskImage.hpp"
+#include "../../src/fdc/FDC.hpp"
+#include "../../src/fdc/ImageCache.hpp"
+
+using Bytes = std::vector<uint8_t>;
+
+// JV3 header: 2901 three-byte entries (track, sector, flags) + write protect.
+constexpr size_t  JV3_HEADER = 2901 * 3 + 1;
+constexpr uint8_t JV3_FREE   = 0xFF;
+
+// FD1771 registers and commands used by the Write Track test
+constexpr uint16_t FDC_CMD   = 0x37EC;
+constexpr uint16_t FDC_DATA  = 0x37EF;
+constexpr uint8_t  CMD_READ_SECTOR = 0x80;
+constexpr uint8_t  CMD_READ_TRACK  = 0xE0;
+constexpr uint8_t  CMD_WRITE_TRACK = 0xF0;
+constexpr uint8_t  ST_BUSY = 0x01;
+constexpr uint8_t  ST_DRQ  = 0x02;
+
+static int test_count = 0;
+static int fail_count = 0;
+
+static void check(bool ok, const char* what) {
+    test_count++;
+    if (ok) return;
+    fail_count++;
+    printf("  FAIL: %s\n", what);
+}
+
+// Sector contents that differ per track and sector and never contain an
+// FM address mark (F7-FE), so a raw track can be scanned for them.
+static Bytes pattern(int track, int sector, int len) {
+    Bytes b(static_cast<size_t>(len));
+    for (int i = 0; i < len; i++) b[static_cast<size_t>(i)] = static_cast<uint8_t>((track * 31 + sector * 7 + i) & 0x7F);
+    return b;
+}
+
+static bool load(DiskImage& img, const Bytes& bytes) {
+    return img.load(ImageCache::intern(bytes));
+}
+
+static bool sector_is(const DiskImage& img, int track, int sector, const Bytes& want, uint8_t dam) {
+    int len; uint8_t got_dam;
+    const uint8_t* p = img.find_sector(track, sector, len, got_dam);
+    return p && len == static_cast<int>(want.size()) && got_dam == dam &&
+           std::memcmp(p, want.data(), want.size()) == 0;
+}
+
+// ============================================================================
+// JV1
+// ============================================================================
+static void test_jv1() {
+    printf("JV1 round trip\n");
+    constexpr int TRACKS = 35;
+    Bytes file;
+    for (int t = 0; t < TRACKS; t++)
+        for (int s = 0; s < DiskImage::JV1_SECTORS; s++) {
+            Bytes p = pattern(t, s, DiskImage::JV1_SECTOR_BYTES);
+            file.insert(file.end(), p.begin(), p.end());
+        }
+
+    DiskImage img;
+    check(load(img, file), "JV1 loads");
+    check(img.format() == DiskImage::Format::JV1, "JV1 detected");
+    check(img.tracks() == TRACKS, "JV1 track count");
+    check(img.serialise() == file, "JV1 serialises unchanged");
+    check(sector_is(img, 3, 4, pattern(3, 4, 256), DiskImage::DAM_NORMAL), "JV1 sector data");
+    check(sector_is(img, DiskImage::JV1_DIR_TRACK, 0, pattern(17, 0, 256), DiskImage::DAM_FA),
+          "JV1 directory track reads with FA");
+
+    Bytes data = pattern(40, 2, 256);
+    check(img.write_sector(5, 2, data.data(), 256, DiskImage::DAM_NORMAL), "JV1 write sector");
+    Bytes want = file;
+    std::memcpy(&want[(5 * DiskImage::JV1_SECTORS + 2) * 256], data.data(), 256);
+    check(img.serialise() == want, "JV1 write lands in its sector only");
+}
+
+// ============================================================================
+// JV3
+// ============================================================================
+struct Jv3Entry {
+    uint8_t track, sector, flags;
+    Bytes   data;
+};
+
+static Bytes jv3(const std::vector<Jv3Entry>& entries) {
+    Bytes file(JV3_HEADER, JV3_FREE);
+    file[JV3_HEADER - 1] = 0x00;                     // write protect: off
+    for (size_t i = 0; i < entries.size(); i++) {
+        file[i * 3]     = entries[i].track;
+        file[i * 3 + 1] = entries[i].sector;
+        file[i * 3 + 2] = entries[i].flags;
+        file.insert(file.end(), entries[i].data.begin(), entries[i].data.end());
+    }
+    return file;
+}
+
+static void test_jv3() {
+    printf("JV3 round trip\n");
+    // Track 0: ten 256-byte sectors (size code 0), sector 1 with an FA mark
+    // (DAM code 1).  Track 1: one 128-byte sector (size code 1).
+    std::vector<Jv3Entry> entries;
+    for (int s = 0; s < 10; s++)
+        entries.push_back({0, static_cast<uint8_t>(s), static_cast<uint8_t>(s == 1 ? 0x20 : 0x00),
+                           pattern(0, s, 256)});
+    entries.push_back({1, 0, 0x01, pattern(1, 0, 128)});
+    Bytes file = jv3(entries);
+
+    DiskImage img;
+    check(load(img, file), "JV3 loads");
+    check(img.format() == DiskImage::Format::JV3, "JV3 detected");
+    check(img.tracks() == 2, "JV3 track count");
+    check(img.serialise() == file, "JV3 serialises unchanged");
+    check(sector_is(img, 0, 1, pattern(0, 1, 256), DiskImage::DAM_FA), "JV3 sector DAM");
+    check(sector_is(img, 1, 0, pattern(1, 0, 128), DiskImage::DAM_NORMAL), "JV3 128-byte sector");
+}
+
+// A free entry (track FF) still occupies data space, sized by the free-entry
+// code table: flags FE is code 2, 128 bytes for a free entry (1024 if it
+// were used).  The sector after it must be found past those 128 bytes.
+static void test_jv3_free_entry() {
+    printf("JV3 free entry\n");
+    std::vector<Jv3Entry> entries = {
+        {0, 0, 0x00, pattern(0, 0, 256)},
+        {JV3_FREE, JV3_FREE, 0xFE, Bytes(128, 0xE5)},
+        {0, 1, 0x00, pattern(0, 1, 256)},
+    };
+    Bytes file = jv3(entries);
+
+    DiskImage img;
+    check(load(img, file), "JV3 with a free entry loads");
+    check(img.format() == DiskImage::Format::JV3, "JV3 with a free entry detected");
+    check(sector_is(img, 0, 0, pattern(0, 0, 256), DiskImage::DAM_NORMAL), "sector before the free entry");
+    check(sector_is(img, 0, 1, pattern(0, 1, 256), DiskImage::DAM_NORMAL), "sector after the free entry");
+
+    // Saving drops the free entry; the sectors survive a reload.
+    DiskImage again;
+    check(load(again, img.serialise()), "JV3 without the free entry reloads");
+    check(sector_is(again, 0, 0, pattern(0, 0, 256), DiskImage::DAM_NORMAL) &&
+          sector_is(again, 0, 1, pattern(0, 1, 256), DiskImage::DAM_NORMAL),
+          "sectors survive the save");
+}
+
+// ============================================================================
+// IMD
+// ============================================================================
+static void test_imd() {
+    printf("IMD round trip\n");
+    static const uint8_t ORDER[10] = {0, 5, 1, 6, 2, 7, 3, 8, 4, 9};
+    const char header[] = "IMD 1.18: 01/01/2026 00:00:00\r\nMal-80 test\x1A";
+    Bytes file(header, header + sizeof(header) - 1);
+    for (int t = 0; t < 2; t++) {
+        // FM 250 kbps, cylinder t, head 0, 10 sectors of 256 bytes
+        Bytes rec = {2, static_cast<uint8_t>(t), 0, 10, 1};
+        rec.insert(rec.end(), ORDER, ORDER + 10);
+        file.insert(file.end(), rec.begin(), rec.end());
+        for (uint8_t s : ORDER) {
+            if (s == 3) {                       // compressed: all E5
+                file.push_back(2);
+                file.push_back(0xE5);
+            } else {                            // normal, or deleted on sector 7
+                file.push_back(s == 7 ? 3 : 1);
+                Bytes p = pattern(t, s, 256);
+                file.insert(file.end(), p.begin(), p.end());
+            }
+        }
+    }
+
+    DiskImage img;
+    check(load(img, file), "IMD loads");
+    check(img.format() == DiskImage::Format::IMD, "IMD detected");
+    check(img.tracks() == 2, "IMD track count");
+    check(img.serialise() == file, "IMD serialises unchanged");
+    check(sector_is(img, 1, 3, Bytes(256, 0xE5), DiskImage::DAM_NORMAL), "IMD compressed sector expands");
+    check(sector_is(img, 1, 7, pattern(1, 7, 256), DiskImage::DAM_FA), "IMD deleted sector reads with FA");
+
+    auto layout = img.track_layout(0, false);
+    bool order = layout.size() == 10;
+    for (size_t i = 0; order && i < layout.size(); i++) order = layout[i].id == ORDER[i];
+    check(order, "IMD track layout in recorded order");
+}
+
+// ============================================================================
+// WRITE TRACK → READ TRACK
+// ============================================================================
+// Raw FM stream a formatter writes: per sector gap, FE ID mark, ID, CRC,
+// gap, data mark, data, CRC; FF fill to the end of the revolution.
+static Bytes format_stream(int track, const uint8_t* order, int count) {
+    Bytes raw(16, 0xFF);
+    auto put = [&](uint8_t b, int n) { raw.insert(raw.end(), static_cast<size_t>(n), b); };
+    for (int i = 0; i < count; i++) {
+        uint8_t s = order[i];
+        put(0x00, 6);
+        raw.insert(raw.end(), {0xFE, static_cast<uint8_t>(track), 0x00, s, 0x01, 0xF7});
+        put(0xFF, 11);
+        put(0x00, 6);
+        raw.push_back(s == 0 ? DiskImage::DAM_FA : DiskImage::DAM_NORMAL);
+        Bytes p = pattern(track, s, 256);
+        raw.insert(raw.end(), p.begin(), p.end());
+        raw.push_back(0xF7);
+        put(0xFF, 12);
+    }
+    raw.resize(FDC::TRACK_BYTES, 0xFF);
+    return raw;
+}
+
+static void test_write_read_track() {
+    printf("Write Track / Read Track\n");
+    static const uint8_t ORDER[10] = {0, 5, 1, 6, 2, 7, 3, 8, 4, 9};
+    FDC fdc;
+    check(fdc.new_disk(0, "unused.dsk"), "blank disk mounts");
+    fdc.select_drive(0x01);
+
+    fdc.write(FDC_CMD, CMD_WRITE_TRACK);
+    for (uint8_t b : format_stream(0, ORDER, 10)) {
+        if (!(fdc.peek_status() & ST_DRQ)) break;
+        fdc.write(FDC_DATA, b);
+    }
+    check(!(fdc.peek_status() & ST_BUSY), "Write Track completes");
+
+    fdc.write(FDC_CMD, CMD_READ_TRACK);
+    Bytes raw;
+    while (fdc.peek_status() & ST_DRQ) raw.push_back(fdc.read(FDC_DATA));
+    check(raw.size() == FDC::TRACK_BYTES, "Read Track delivers one revolution");
+
+    // Each ID mark in the stream is followed by its data mark and data.
+    int found = 0;
+    for (size_t i = 0; i + 5 < raw.size(); i++) {
+        if (raw[i] != 0xFE || raw[i + 1] != 0 || raw[i + 2] != 0 || raw[i + 4] != 0x01) continue;
+        uint8_t s = raw[i + 3];
+        size_t  d = i + 5;
+        while (d < raw.size() && raw[d] != DiskImage::DAM_NORMAL && raw[d] != DiskImage::DAM_FA) d++;
+        if (d + 257 > raw.size()) break;
+        Bytes want = pattern(0, s, 256);
+        bool mark = raw[d] == (s == 0 ? DiskImage::DAM_FA : DiskImage::DAM_NORMAL);
+        if (ORDER[found] == s && mark && std::memcmp(&raw[d + 1], want.data(), 256) == 0) found++;
+        i = d + 256;
+        if (found == 10) break;
+    }
+    check(found == 10, "Read Track returns the sectors written, in order");
+
+    fdc.write(0x37EE, 6);                      // sector register
+    fdc.write(FDC_CMD, CMD_READ_SECTOR);
+    Bytes data;
+    while (fdc.peek_status() & ST_DRQ) data.push_back(fdc.read(FDC_DATA));
+    check(data == pattern(0, 6, 256), "Read Sector finds a formatted sector");
+
+    DiskImage img;
+    check(load(img, fdc.image_bytes(0)) && sector_is(img, 0, 0, pattern(0, 0, 256), DiskImage::DAM_FA),
+          "formatted track survives a save");
+}
+
+int main() {
+    printf("Mal-80 disk format tests\n\n");
+    test_jv1();
+    test_jv3();
+    test_jv3_free_entry();
+    test_imd();
+    test_write_read_track();
+    printf("\n%d checks, %d failures\n", test_count, fail_count);
+    return fail_count > 0 ? 1 : 0;
+}
@@ -0,0 +1,539 @@
+// tools/bisect/main.cpp
+// divergence_bisect — find the first instruction where two configurations
+// of the emulator stop agreeing
+//
+// Both machines start from the same power-on state (same ROM, disks and
+// typed input) and run in parallel threads, one per configuration.  Every
+// CHECK steps their state hashes are compared — CPU registers, VRAM, RAM,
+// ROM shadow and, unless --ignore-timing, the T-state clock.  While they
+// agree, each side keeps a snapshot of that checkpoint.  On the first
+// mismatch both are rolled back and the interval is bisected: run half of
+// it, compare, keep the half that still holds the divergence (moving the
+// snapshot forward when the first half agreed).  About CHECK steps of
+// re-execution in all — a billion-instruction run localises in seconds.
+//
+// The report names the step, the instruction each side executed there (or
+// the native routine that replaced it), the registers that differ after it
+// and the memory bytes that differ.
+//
+// A step is one guest instruction, or one whole call to a routine that
+// either side replaces natively: the --fp-hle arithmetic entries, $DSP
+// for --video-hle, or a DRQ copy loop with data ready for --fast-disk.
+// The side that intercepts finishes the routine in one pass of CoreStep;
+// the side that interprets it keeps stepping until the call returns (SP
+// back above the return address) or the copy loop is back at its head with
+// nothing left to move.  So both sides are compared at the same sync
+// points, outside the replaced routines.  IM 1 acknowledge belongs to the
+// step it follows.
+//
+// The native routines reproduce a routine's results, not its leftovers, so
+// after one the compare skips what only the ROM code touches: the stack it
+// used below the caller's SP (until the guest pushes over it again) and
+// its scratch registers A, F and HL (until the guest writes them).  With
+// --ignore-timing the R refresh counter is skipped too: it counts executed
+// instructions, so it follows the clock.
+//
+// Usage: divergence_bisect [options] -a <config> -b <config>
+//        Exit status 0 if the runs never diverge, 1 if they do.
+
+#include "../../src/cpu/z80.hpp"
+#include "../../src/cpu/Disasm.hpp"
+#include "../../src/cpu/RomXlat.hpp"
+#include "../../src/system/Bus.hpp"
+#include "../../src/system/Fnv1a.hpp"
+#include "../../src/fdc/FastDisk.hpp"
+#include "../../src/KeyInjector.hpp"
+#include "../../src/FloatHLE.hpp"
+#include "../../src/VideoHLE.hpp"
+#include "../../src/CoreStep.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr uint64_t DEFAULT_CHECK = 1000000;
+static constexpr uint64_t DEFAULT_STEPS = 10000000000ull;
+static constexpr int      MAX_MEM_DIFFS = 8;
+static constexpr uint64_t MAX_CALL_STEPS = 1ull << 24;   // interpreting one replaced call
+static constexpr int      FRAME_GAP     = 16;           // merge dead stack frames this close
+
+// Registers a replaced routine may leave behind that its native version
+// does not reproduce (bits of Machine::scratch).
+enum : uint8_t { SCRATCH_A = 1, SCRATCH_F = 2, SCRATCH_HL = 4 };
+
+// Dead stack a replaced routine used, [lo, hi) below the caller's SP.
+struct Frame {
+    uint16_t lo, hi;
+};
+
+// What a step ran, for the report.  `call`: the step was a replaceable
+// routine, so CPU means the ROM code ran it to the end.
+static const char* kind_name(CoreStep::Kind k, bool call) {
+    switch (k) {
+        case CoreStep::Kind::KEY:       return "$KEY injection";
+        case CoreStep::Kind::FP_HLE:    return "native FP routine (--fp-hle)";
+        case CoreStep::Kind::VIDEO_HLE: return "native $DSP (--video-hle)";
+        case CoreStep::Kind::FAST_DISK: return "fast sector copy (--fast-disk)";
+        default:                        return call ? "ROM routine, run to its return" : "instruction";
+    }
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+struct Config {
+    std::string name;
+    bool fast_disk    = false;
+    bool fp_hle       = false;
+    bool video_hle    = false;
+    bool fdc_accurate = false;
+    bool rom_xlat     = false;
+};
+
+// "fast-disk,fp-hle" etc.  "base" (or empty) is the plain interpreter.
+static bool parse_config(const std::string& spec, Config& c) {
+    c.name = spec.empty() ? "base" : spec;
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if      (item == "" || item == "base") {}
+        else if (item == "fast-disk")    c.fast_disk    = true;
+        else if (item == "fp-hle")       c.fp_hle       = true;
+        else if (item == "video-hle")    c.video_hle    = true;
+        else if (item == "fdc-accurate") c.fdc_accurate = true;
+        else if (item == "rom-xlat")     c.rom_xlat     = true;
+        else {
+            std::fprintf(stderr, "Unknown config item '%s'\n", item.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// MACHINE
+// ============================================================================
+struct Machine {
+    Bus         bus;             // must precede cpu (Z80 holds a reference)
+    Z80         cpu;
+    KeyInjector injector;
+    FloatHLE    fp;
+    VideoHLE    video;
+    FastDisk    fast_disk;
+    CoreStep    core{cpu, bus, injector, fp, video, fast_disk};   // no loader hooks
+    uint8_t     keys[8]{};
+    uint64_t    steps  = 0;        // aligned steps
+    uint64_t    passes = 0;        // CoreStep passes (instructions + intercepts)
+    CoreStep::Kind last = CoreStep::Kind::CPU;
+    bool        last_call = false; // the last step ran a replaceable routine
+
+    // Routines either configuration replaces; set on both sides alike.
+    bool sync_fp = false, sync_video = false, sync_disk = false;
+
+    // What the replaced routines left that the compare skips.
+    uint8_t            scratch = 0;
+    std::vector<Frame> frames;
+
+    Machine() : cpu(bus) { bus.set_keyboard_matrix(keys); }
+
+    void configure(const Config& c) {
+        bus.fdc().set_timing(c.fdc_accurate ? FDC::Timing::ACCURATE : FDC::Timing::ZERO_LATENCY);
+        fast_disk.set_enabled(c.fast_disk);
+        fp.set_mode(c.fp_hle ? FloatHLE::Mode::ON : FloatHLE::Mode::OFF);
+        video.set_mode(c.video_hle ? VideoHLE::Mode::ON : VideoHLE::Mode::OFF);
+        fp.attach(bus);
+        video.attach(bus);
+        if (c.rom_xlat) RomXlat::attach(cpu, bus);
+    }
+
+    void pass() {
+        uint64_t ts = 0;
+        passes++;
+        last = core.step(ts);
+    }
+
+    void step() {
+        steps++;
+        uint16_t pc0 = cpu.get_pc(), sp0 = cpu.get_sp();
+        bool loop = sync_disk && FastDisk::ready(pc0, cpu, bus);
+        last_call = loop || (sync_fp && fp.is_entry(pc0)) || (sync_video && video.is_entry(pc0));
+        if (!last_call) {
+            uint8_t a = cpu.get_a(), f = cpu.get_f();
+            uint16_t hl = cpu.get_hl();
+            pass();
+            // Scratch registers stay skipped until the guest changes them.
+            if ((scratch & SCRATCH_A) && cpu.get_a() != a) scratch &= ~SCRATCH_A;
+            if ((scratch & SCRATCH_F) && cpu.get_f() != f) scratch &= ~SCRATCH_F;
+            if ((scratch & SCRATCH_HL) && cpu.get_hl() != hl) scratch &= ~SCRATCH_HL;
+            return;
+        }
+
+        // Run the call (or copy loop) to its end; one pass if intercepted.
+        uint16_t ret  = static_cast<uint16_t>(bus.peek(sp0) | bus.peek(static_cast<uint16_t>(sp0 + 1)) << 8);
+        uint16_t done = static_cast<uint16_t>(sp0 + 2);
+        uint16_t lo   = sp0;
+        CoreStep::Kind first = CoreStep::Kind::CPU;
+        for (uint64_t n = 0; n < MAX_CALL_STEPS; n++) {
+            pass();
+            if (n == 0) first = last;
+            uint16_t pc = cpu.get_pc(), sp = cpu.get_sp();
+            if (loop ? pc == pc0 && !FastDisk::ready(pc, cpu, bus)
+                     : (pc == ret && sp == done) || sp > done)   // returned, or unwound by an error
+                break;
+            lo = std::min(lo, sp);
+        }
+        last = first;
+        if (loop) return;    // the copy loop has no leftovers
+        scratch |= SCRATCH_A | SCRATCH_F | SCRATCH_HL;
+        if (lo < sp0) add_frame(lo, sp0);
+    }
+
+    void add_frame(uint16_t lo, uint16_t hi) {
+        for (Frame& f : frames) {
+            if (lo <= f.hi + FRAME_GAP && f.lo <= hi + FRAME_GAP) {
+                f.lo = std::min(f.lo, lo);
+                f.hi = std::max(f.hi, hi);
+                return;
+            }
+        }
+        frames.push_back({lo, hi});
+    }
+
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) step();
+    }
+};
+
+// Everything a step can change, including disk contents (a DOS may write a
+// sector and read it back inside one checkpoint interval).
+struct Snapshot {
+    Z80::State                  cpu;
+    std::unique_ptr<Bus::State> bus = std::make_unique<Bus::State>();
+    KeyInjector                 injector;
+    FloatHLE                    fp;
+    VideoHLE                    video;
+    FastDisk                    fast_disk;
+    std::vector<uint8_t>        disks[FDC::DRIVES];
+    uint64_t                    steps = 0, passes = 0;
+    uint8_t                     scratch = 0;
+    std::vector<Frame>          frames;
+};
+
+static void save(const Machine& m, Snapshot& s) {
+    s.cpu = m.cpu.save_state();
+    m.bus.save_state(*s.bus);
+    s.injector  = m.injector;
+    s.fp        = m.fp;
+    s.video     = m.video;
+    s.fast_disk = m.fast_disk;
+    for (int d = 0; d < FDC::DRIVES; d++)
+        s.disks[d] = const_cast<Machine&>(m).bus.fdc().image_bytes(d);
+    s.steps   = m.steps;
+    s.passes  = m.passes;
+    s.scratch = m.scratch;
+    s.frames  = m.frames;
+}
+
+static void restore(Machine& m, const Snapshot& s) {
+    // Remount only drives whose contents moved on since the snapshot.
+    for (int d = 0; d < FDC::DRIVES; d++) {
+        if (!s.disks[d].empty() && m.bus.fdc().image_bytes(d) != s.disks[d])
+            m.bus.fdc().load_disk_bytes(d, s.disks[d], m.bus.fdc().get_disk_name(d));
+    }
+    m.cpu.load_state(s.cpu);
+    m.bus.load_state(*s.bus);
+    m.injector  = s.injector;
+    m.fp        = s.fp;
+    m.video     = s.video;
+    m.fast_disk = s.fast_disk;
+    m.steps     = s.steps;
+    m.passes    = s.passes;
+    m.scratch   = s.scratch;
+    m.frames    = s.frames;
+}
+
+// ============================================================================
+// COMPARISON
+// ============================================================================
+static bool g_timing = true;    // --ignore-timing clears
+
+// Registers field by field: Z80::Registers has padding.
+static void regs_of(const Machine& m, uint16_t out[16]) {
+    Z80::State s = m.cpu.save_state();
+    const auto& r = s.reg;
+    uint16_t v[16] = {
+        static_cast<uint16_t>(r.a << 8 | r.f), r.bc, r.de, r.hl,
+        static_cast<uint16_t>(r.a2 << 8 | r.f2), r.bc2, r.de2, r.hl2,
+        r.ix, r.iy, r.sp, r.pc,
+        static_cast<uint16_t>(r.i << 8 | r.r), r.im,
+        static_cast<uint16_t>(r.iff1 | r.iff2 << 1 | r.halted << 2 | r.ei_pending << 3),
+        s.prefix,
+    };
+    std::memcpy(out, v, sizeof(v));
+}
+static const char* REG_NAMES[16] = {"AF", "BC", "DE", "HL", "AF'", "BC'", "DE'", "HL'",
+                                    "IX", "IY", "SP", "PC", "IR", "IM", "IFF", "prefix"};
+enum { REG_AF = 0, REG_HL = 3, REG_IR = 12 };
+
+// What both sides leave out of the compare: the union of their scratch
+// registers, and their dead stack frames below the current SP.
+struct Skip {
+    uint16_t           regs[16];   // AND masks
+    std::vector<Frame> dead;
+
+    Skip(const Machine& a, const Machine& b) {
+        std::fill(std::begin(regs), std::end(regs), 0xFFFF);
+        uint8_t sc = a.scratch | b.scratch;
+        if (sc & SCRATCH_A)  regs[REG_AF] &= 0x00FF;
+        if (sc & SCRATCH_F)  regs[REG_AF] &= 0xFF00;
+        if (sc & SCRATCH_HL) regs[REG_HL] = 0;
+        if (!g_timing)       regs[REG_IR] &= 0xFF00;
+        uint16_t sp = std::min(a.cpu.get_sp(), b.cpu.get_sp());
+        for (const Machine* m : {&a, &b}) {
+            for (const Frame& f : m->frames)
+                if (f.lo < sp) dead.push_back({f.lo, std::min(f.hi, sp)});
+        }
+    }
+    bool is_dead(uint16_t addr) const {
+        for (const Frame& f : dead)
+            if (addr >= f.lo && addr < f.hi) return true;
+        return false;
+    }
+};
+
+static uint64_t state_hash(const Machine& m, Bus::State& scratch, const Skip& skip) {
+    uint16_t regs[16];
+    regs_of(m, regs);
+    for (int i = 0; i < 16; i++) regs[i] &= skip.regs[i];
+    m.bus.save_state(scratch);
+    for (const Frame& f : skip.dead) {
+        for (uint32_t addr = std::max<uint32_t>(f.lo, RAM_START); addr < f.hi; addr++)
+            scratch.ram[addr - RAM_START] = 0;
+    }
+    uint64_t h = fnv1a(regs, sizeof(regs));
+    h = fnv1a(scratch.vram.data(), scratch.vram.size(), h);
+    h = fnv1a(scratch.ram.data(), scratch.ram.size(), h);
+    h = fnv1a(scratch.rom_shadow.data(), scratch.rom_shadow.size(), h);
+    h = fnv1a(scratch.rom_shadow_active.data(), scratch.rom_shadow_active.size(), h);
+    if (g_timing) h = fnv1a(&scratch.global_t_states, sizeof(scratch.global_t_states), h);
+    return h;
+}
+
+// Run both machines `n` steps, one thread each, and compare.
+struct Pair {
+    Machine    a, b;
+    Bus::State ha, hb;    // hashing scratch, ~75KB each
+
+    bool run_and_compare(uint64_t n) {
+        std::thread tb([&] { b.run(n); });
+        a.run(n);
+        tb.join();
+        return same();
+    }
+    bool same() {
+        uint64_t x = 0, y = 0;
+        Skip skip(a, b);
+        std::thread tb([&] { y = state_hash(b, hb, skip); });
+        x = state_hash(a, ha, skip);
+        tb.join();
+        return x == y;
+    }
+};
+
+// ============================================================================
+// REPORT
+// ============================================================================
+static std::string disasm(const Machine& m, uint16_t pc) {
+    uint8_t bytes[Disasm::MAX_LEN];
+    for (int i = 0; i < Disasm::MAX_LEN; i++) bytes[i] = m.bus.peek(static_cast<uint16_t>(pc + i));
+    char text[Disasm::TEXT_LEN];
+    int len = Disasm::decode(bytes, pc, text, sizeof(text));
+    char line[96];
+    int  o = std::snprintf(line, sizeof(line), "%04X  ", pc);
+    for (int i = 0; i < Disasm::MAX_LEN; i++)
+        o += std::snprintf(line + o, sizeof(line) - o, i < len ? "%02X " : "   ", bytes[i]);
+    std::snprintf(line + o, sizeof(line) - o, " %s", text);
+    return line;
+}
+
+static void report(Pair& p, const Config& ca, const Config& cb) {
+    // Both machines are in the last agreeing state; the next step diverges.
+    uint16_t pc_a = p.a.cpu.get_pc(), pc_b = p.b.cpu.get_pc();
+    std::string ins_a = disasm(p.a, pc_a), ins_b = disasm(p.b, pc_b);
+    uint64_t t0_a = p.a.bus.get_global_t_states(), t0_b = p.b.bus.get_global_t_states();
+    p.a.step();
+    p.b.step();
+
+    std::printf("\nFirst divergence at step %llu (T-state %llu; %llu passes on A, %llu on B):\n",
+                static_cast<unsigned long long>(p.a.steps), static_cast<unsigned long long>(t0_a),
+                static_cast<unsigned long long>(p.a.passes), static_cast<unsigned long long>(p.b.passes));
+    int w = static_cast<int>(std::max(ca.name.size(), cb.name.size())) + 2;
+    std::string la = "[" + ca.name + "]", lb = "[" + cb.name + "]";
+    std::printf("  A %-*s %s — %s\n", w, la.c_str(), ins_a.c_str(), kind_name(p.a.last, p.a.last_call));
+    std::printf("  B %-*s %s — %s\n", w, lb.c_str(), ins_b.c_str(), kind_name(p.b.last, p.b.last_call));
+
+    Skip skip(p.a, p.b);
+    uint16_t ra[16], rb[16];
+    regs_of(p.a, ra);
+    regs_of(p.b, rb);
+    std::printf("\nRegisters after the step:\n");
+    bool any = false;
+    for (int i = 0; i < 16; i++) {
+        if (((ra[i] ^ rb[i]) & skip.regs[i]) == 0) continue;
+        std::printf("  %-6s A %04X  B %04X\n", REG_NAMES[i], ra[i], rb[i]);
+        any = true;
+    }
+    uint64_t dt_a = p.a.bus.get_global_t_states() - t0_a, dt_b = p.b.bus.get_global_t_states() - t0_b;
+    if (dt_a != dt_b) {
+        std::printf("  %-6s A %llu  B %llu\n", "T", static_cast<unsigned long long>(dt_a),
+                    static_cast<unsigned long long>(dt_b));
+        any = true;
+    }
+    if (!any) std::printf("  (identical)\n");
+
+    std::printf("\nMemory after the step:\n");
+    int diffs = 0;
+    uint32_t first = 0;
+    for (uint32_t addr = 0; addr <= 0xFFFF; addr++) {
+        uint8_t x = p.a.bus.peek(static_cast<uint16_t>(addr)), y = p.b.bus.peek(static_cast<uint16_t>(addr));
+        if (x == y || skip.is_dead(static_cast<uint16_t>(addr))) continue;
+        if (diffs == 0) first = addr;
+        if (diffs < MAX_MEM_DIFFS) std::printf("  %04X   A %02X  B %02X\n", addr, x, y);
+        diffs++;
+    }
+    if (diffs > MAX_MEM_DIFFS) std::printf("  ... %d bytes differ in all\n", diffs);
+    else if (diffs == 0)       std::printf("  (identical)\n");
+    else                       std::printf("  first differing byte: %04X\n", first);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+static void usage() {
+    std::fprintf(stderr,
+        "Usage: divergence_bisect [options] -a <config> -b <config>\n"
+        "\n"
+        "  <config>            Comma-separated: fast-disk, fp-hle, video-hle,\n"
+        "                      fdc-accurate, rom-xlat; base = plain interpreter.\n"
+        "  --rom <path>        ROM image (default roms/level2.rom)\n"
+        "  --disk <n> <path>   Mount a disk image on drive n (0-3) on both sides\n"
+        "  --type <text>       Type text through $KEY (\\n = ENTER)\n"
+        "  --bas <file>        Type a BASIC program (NEW first)\n"
+        "  --steps <n>         Give up after n steps (default 10,000,000,000)\n"
+        "  --check <n>         Steps between checkpoints (default 1,000,000)\n"
+        "  --ignore-timing     Compare registers and memory only, not the clock\n"
+        "                      (T-states and the R register)\n");
+}
+
+static std::string unescape(const std::string& s) {
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '\\' && i + 1 < s.size() && s[i + 1] == 'n') { out += '\n'; i++; }
+        else out += s[i];
+    }
+    return out;
+}
+
+int main(int argc, char* argv[]) {
+    std::string rom_path = "roms/level2.rom", disks[FDC::DRIVES], type_text, bas_path;
+    std::string spec_a, spec_b;
+    bool have_a = false, have_b = false;
+    uint64_t max_steps = DEFAULT_STEPS, check = DEFAULT_CHECK;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if      (arg == "-a" && i + 1 < argc) { spec_a = argv[++i]; have_a = true; }
+        else if (arg == "-b" && i + 1 < argc) { spec_b = argv[++i]; have_b = true; }
+        else if (arg == "--rom" && i + 1 < argc) rom_path = argv[++i];
+        else if (arg == "--disk" && i + 2 < argc) {
+            int d = std::atoi(argv[++i]);
+            if (d < 0 || d >= FDC::DRIVES) { usage(); return 2; }
+            disks[d] = argv[++i];
+        }
+        else if (arg == "--type" && i + 1 < argc) type_text = unescape(argv[++i]);
+        else if (arg == "--bas" && i + 1 < argc) bas_path = argv[++i];
+        else if (arg == "--steps" && i + 1 < argc) max_steps = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--check" && i + 1 < argc) check = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--ignore-timing") g_timing = false;
+        else { usage(); return 2; }
+    }
+    Config ca, cb;
+    if (!have_a || !have_b || check == 0 || !parse_config(spec_a, ca) || !parse_config(spec_b, cb)) {
+        usage();
+        return 2;
+    }
+
+    auto pair = std::make_unique<Pair>();
+    for (Machine* m : {&pair->a, &pair->b}) {
+        try {
+            m->bus.load_rom(rom_path);
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s\n", e.what());
+            return 2;
+        }
+        for (int d = 0; d < FDC::DRIVES; d++) {
+            if (!disks[d].empty() && !m->bus.load_disk(d, disks[d])) return 2;
+        }
+        if (!bas_path.empty()) m->injector.load_bas(bas_path);
+        if (!type_text.empty()) m->injector.enqueue(type_text);
+        m->cpu.reset();
+    }
+    pair->a.configure(ca);
+    pair->b.configure(cb);
+    for (Machine* m : {&pair->a, &pair->b}) {
+        m->sync_fp    = ca.fp_hle || cb.fp_hle;
+        m->sync_video = ca.video_hle || cb.video_hle;
+        m->sync_disk  = ca.fast_disk || cb.fast_disk;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto elapsed = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    // Checkpoint scan: both sides run CHECK steps, then compare.
+    auto good_a = std::make_unique<Snapshot>(), good_b = std::make_unique<Snapshot>();
+    save(pair->a, *good_a);
+    save(pair->b, *good_b);
+    uint64_t span = 0;
+    while (pair->a.steps < max_steps) {
+        span = std::min(check, max_steps - pair->a.steps);
+        if (!pair->run_and_compare(span)) break;
+        save(pair->a, *good_a);
+        save(pair->b, *good_b);
+        span = 0;
+    }
+    if (span == 0) {
+        std::printf("No divergence in %llu steps (%.1f s)\n",
+                    static_cast<unsigned long long>(pair->a.steps), elapsed());
+        return 0;
+    }
+    std::printf("Checkpoint mismatch between steps %llu and %llu (%.1f s) — bisecting\n",
+                static_cast<unsigned long long>(good_a->steps),
+                static_cast<unsigned long long>(good_a->steps + span), elapsed());
+
+    // Bisect (good, good + span]: the state agrees at `good`, not at its end.
+    while (span > 1) {
+        uint64_t half = span / 2;
+        restore(pair->a, *good_a);
+        restore(pair->b, *good_b);
+        if (pair->run_and_compare(half)) {
+            save(pair->a, *good_a);
+            save(pair->b, *good_b);
+            span -= half;
+        } else {
+            span = half;
+        }
+    }
+    restore(pair->a, *good_a);
+    restore(pair->b, *good_b);
+    report(*pair, ca, cb);
+    std::printf("\n(%.1f s)\n", elapsed());
+    return 1;
+}
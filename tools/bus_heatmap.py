@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Bus access heatmap from a mal-80 --bus-stats file
+============================================================================
+
+Each line of the input is one window of emulated time (see
+src/system/BusStats.hpp).  The image has one row per window and one column
+per 256-byte page, scaled 2x; brightness is log(accesses per second):
+
+    red   = writes     green = reads     blue = M1 opcode fetches
+
+so a keyboard scan shows up as a green stripe at page 38, a DRQ polling
+loop as a green stripe at 37 beside a blue one where the loop lives.
+
+Also prints the device counters per window (accesses per emulated second).
+Pure Python, writes a binary PPM — convert with any image tool.
+
+Usage:
+  python3 tools/bus_heatmap.py busstats.jsonl heatmap.ppm
+  python3 tools/bus_heatmap.py busstats.jsonl heatmap.ppm --devices
+"""
+import json
+import math
+import sys
+
+T_PER_SECOND = 29498 * 60
+SCALE = 2
+
+
+def load(path):
+    with open(path) as f:
+        return [json.loads(line) for line in f if line.strip()]
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith('--')]
+    if len(args) != 2:
+        print(__doc__.strip().split('Usage:')[1], file=sys.stderr)
+        sys.exit(2)
+    windows = load(args[0])
+    if not windows:
+        sys.exit(f'{args[0]}: no windows')
+
+    # Rates per second, then one log scale for all three channels.
+    def rate(w, kind, page):
+        return w[kind][page] * T_PER_SECOND / w['t_states']
+
+    peak = max(rate(w, k, p) for w in windows for k in ('fetch', 'read', 'write')
+               for p in range(256))
+    top = math.log1p(peak) or 1.0
+
+    def level(v):
+        return int(255 * math.log1p(v) / top)
+
+    width, height = 256 * SCALE, len(windows) * SCALE
+    pixels = bytearray()
+    for w in windows:
+        row = bytearray()
+        for p in range(256):
+            rgb = bytes((level(rate(w, 'write', p)), level(rate(w, 'read', p)),
+                         level(rate(w, 'fetch', p))))
+            row += rgb * SCALE
+        pixels += bytes(row) * SCALE
+    with open(args[1], 'wb') as f:
+        f.write(b'P6\n%d %d\n255\n' % (width, height))
+        f.write(pixels)
+    print(f'{args[1]}: {len(windows)} windows x 256 pages, peak {peak:,.0f} accesses/s per page')
+
+    if '--devices' in sys.argv:
+        names = [n for n in windows[0]['io'] if any(w['io'][n] for w in windows)]
+        print('frame   ' + ' '.join(f'{n:>16}' for n in names))
+        for w in windows:
+            s = w['t_states'] / T_PER_SECOND
+            print(f"{w['frame']:<7} " + ' '.join(f"{w['io'][n] / s:16,.0f}" for n in names))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,360 @@
+// tools/coverage/main.cpp
+// coverage_report — merge coverage files and report them per address range
+//
+// Input is any number of files written by mal-80 --coverage, libmal80's
+// mal80_coverage_merge() or an earlier -o; bits are ORed and run counts
+// added.  For each range (default: rom 0000-2FFF, ram 4000-FFFF) it prints
+// instructions and branch outcomes hit, and with --lcov writes one lcov
+// record per range: a "line" is an address, numbered from 1 at the start of
+// the range, and each conditional branch has two outcomes, taken and not
+// taken.  genhtml and the usual lcov tooling read the result.
+//
+// A coverage file only knows what ran.  Given the memory it ran from
+// (--image, e.g. the ROM), the report also finds the code that did not:
+// it decodes every executed instruction, follows the branch outcomes never
+// seen and everything reachable from there, and counts those instructions
+// as found but not hit.  Static discovery stops at computed jumps and can
+// be misled by data after RST 08h-style inline arguments, so the found
+// counts are a lower bound.  With --image, --lcov also writes a listing
+// per range (<name>.asm next to the .info file, one line per address) for
+// SF: to point at, so genhtml shows annotated disassembly.
+//
+// Usage: coverage_report [options] <file.cov>...
+//        Exit status 0, or 2 on bad usage or unreadable input.
+
+#include "../../src/cpu/Coverage.hpp"
+#include "../../src/cpu/Disasm.hpp"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Range {
+    std::string name;
+    uint16_t    start = 0, end = 0;   // inclusive
+};
+
+// "name=START-END", hex addresses.
+bool parse_range(const std::string& spec, Range& r) {
+    size_t eq = spec.find('='), dash = spec.find('-', eq + 1);
+    if (eq == std::string::npos || eq == 0 || dash == std::string::npos) return false;
+    char* e1;
+    char* e2;
+    unsigned long s = std::strtoul(spec.c_str() + eq + 1, &e1, 16);
+    unsigned long e = std::strtoul(spec.c_str() + dash + 1, &e2, 16);
+    if (*e1 != '-' || *e2 || s > e || e > 0xFFFF) return false;
+    r = {spec.substr(0, eq), static_cast<uint16_t>(s), static_cast<uint16_t>(e)};
+    return true;
+}
+
+// ============================================================================
+// STATIC DISCOVERY
+// ============================================================================
+// Memory supplied with --image, and what is known about each address.
+struct Memory {
+    std::array<uint8_t, 0x10000> bytes{};
+    std::array<bool, 0x10000>    loaded{};
+    bool any = false;
+
+    // "file@ADDR": raw bytes loaded at hex ADDR.
+    bool load(const std::string& spec) {
+        size_t at = spec.rfind('@');
+        std::string path = spec.substr(0, at);
+        unsigned long addr = at == std::string::npos ? 0 : std::strtoul(spec.c_str() + at + 1, nullptr, 16);
+        std::ifstream f(path, std::ios::binary);
+        if (!f || addr > 0xFFFF) {
+            std::fprintf(stderr, "Cannot read image %s\n", path.c_str());
+            return false;
+        }
+        char c;
+        for (unsigned long a = addr; a <= 0xFFFF && f.get(c); a++) {
+            bytes[a]  = static_cast<uint8_t>(c);
+            loaded[a] = true;
+        }
+        any = true;
+        return true;
+    }
+
+    bool loaded_at(uint16_t addr, int len) const {
+        for (int i = 0; i < len; i++)
+            if (!loaded[static_cast<uint16_t>(addr + i)]) return false;
+        return true;
+    }
+
+    int decode(uint16_t addr, char* text, size_t cap) const {
+        uint8_t b[Disasm::MAX_LEN];
+        for (int i = 0; i < Disasm::MAX_LEN; i++) b[i] = bytes[static_cast<uint16_t>(addr + i)];
+        return Disasm::decode(b, addr, text, cap);
+    }
+};
+
+// Control flow of one decoded instruction.
+struct Flow {
+    bool     conditional = false;   // has a taken and a not-taken outcome
+    bool     falls       = true;    // can continue at the next instruction
+    bool     has_target  = false;
+    uint16_t target      = 0;
+};
+
+bool starts_with(const char* s, const char* p) { return std::strncmp(s, p, std::strlen(p)) == 0; }
+
+Flow flow_of(const char* text) {
+    Flow f;
+    const char* hex = std::strstr(text, "0x");
+    bool jump = starts_with(text, "JP ") || starts_with(text, "JR ") ||
+                starts_with(text, "CALL ") || starts_with(text, "DJNZ ");
+    if (jump && hex && !std::strchr(text, '(')) {
+        f.has_target = true;
+        f.target = static_cast<uint16_t>(std::strtoul(hex, nullptr, 16));
+    }
+    if (starts_with(text, "RST ") && hex) {
+        f.has_target = true;
+        f.target = static_cast<uint16_t>(std::strtoul(hex, nullptr, 16));
+    }
+    bool cond = std::strchr(text, ',') != nullptr;    // "JR NZ,0x..", "CALL C,0x.."
+    if (starts_with(text, "DJNZ ") || ((starts_with(text, "JP ") || starts_with(text, "JR ") ||
+                                        starts_with(text, "CALL ")) && cond && f.has_target))
+        f.conditional = true;
+    else if (starts_with(text, "RET ")) f.conditional = true;       // RET cc
+    else if (!std::strcmp(text, "LDIR") || !std::strcmp(text, "LDDR") || !std::strcmp(text, "CPIR") ||
+             !std::strcmp(text, "CPDR") || !std::strcmp(text, "INIR") || !std::strcmp(text, "INDR") ||
+             !std::strcmp(text, "OTIR") || !std::strcmp(text, "OTDR"))
+        f.conditional = true;
+
+    if (!f.conditional && (starts_with(text, "JP ") || starts_with(text, "JR ") ||
+                           !std::strcmp(text, "RET") || !std::strcmp(text, "RETI") ||
+                           !std::strcmp(text, "RETN")))
+        f.falls = false;
+    return f;
+}
+
+// Instruction starts in [r.start, r.end]: every executed one, plus, when the
+// memory is known, the unexecuted code reachable from branch outcomes never
+// seen.  len[] is 0 for addresses that start no known instruction.
+void discover(const Coverage& cov, const Memory& mem, const Range& r, std::vector<uint8_t>& len) {
+    len.assign(0x10000, 0);
+    std::vector<bool> owned(0x10000, false);   // byte of a known instruction
+    std::vector<uint16_t> work;
+    char text[Disasm::TEXT_LEN];
+
+    auto claim = [&](uint16_t a, int n) {
+        for (int i = 0; i < n; i++)
+            if (owned[static_cast<uint16_t>(a + i)]) return false;
+        for (int i = 0; i < n; i++) owned[static_cast<uint16_t>(a + i)] = true;
+        len[a] = static_cast<uint8_t>(n);
+        return true;
+    };
+    auto in_range = [&](uint32_t a) { return a >= r.start && a <= r.end; };
+
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        if (!Coverage::test(cov.executed, static_cast<uint16_t>(a))) continue;
+        int n = mem.loaded_at(static_cast<uint16_t>(a), Disasm::MAX_LEN)
+                    ? mem.decode(static_cast<uint16_t>(a), text, sizeof(text)) : 1;
+        len[a] = static_cast<uint8_t>(n);
+        for (int i = 0; i < n; i++) owned[static_cast<uint16_t>(a + i)] = true;
+    }
+    if (!mem.any) return;
+
+    // Seeds: the side of each executed branch that never happened.
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        if (!len[a] || !mem.loaded_at(static_cast<uint16_t>(a), Disasm::MAX_LEN)) continue;
+        int n = mem.decode(static_cast<uint16_t>(a), text, sizeof(text));
+        Flow f = flow_of(text);
+        if (!f.conditional || !Coverage::test(cov.branch, static_cast<uint16_t>(a))) continue;
+        if (!Coverage::test(cov.taken, static_cast<uint16_t>(a)) && f.has_target)
+            work.push_back(f.target);
+        if (!Coverage::test(cov.not_taken, static_cast<uint16_t>(a)))
+            work.push_back(static_cast<uint16_t>(a + n));
+    }
+
+    while (!work.empty()) {
+        uint16_t a = work.back();
+        work.pop_back();
+        if (!in_range(a) || len[a] || !mem.loaded_at(a, Disasm::MAX_LEN)) continue;
+        int n = mem.decode(a, text, sizeof(text));
+        if (!claim(a, n)) continue;
+        Flow f = flow_of(text);
+        if (f.has_target) work.push_back(f.target);
+        if (f.falls || f.conditional) work.push_back(static_cast<uint16_t>(a + n));
+    }
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+struct Counts {
+    int found = 0, hit = 0;             // instruction starts
+    int branches = 0, outcomes = 0;     // outcome pairs found / outcomes hit
+};
+
+// Conditional branch at `a`, per the map or (unexecuted) the decoded code.
+bool is_branch(const Coverage& cov, const Memory& mem, uint16_t a) {
+    if (Coverage::test(cov.branch, a)) return true;
+    if (!mem.any || !mem.loaded_at(a, Disasm::MAX_LEN)) return false;
+    char text[Disasm::TEXT_LEN];
+    mem.decode(a, text, sizeof(text));
+    return flow_of(text).conditional;
+}
+
+Counts count(const Coverage& cov, const Memory& mem, const Range& r, const std::vector<uint8_t>& len) {
+    Counts c;
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        if (!len[a]) continue;
+        uint16_t pc = static_cast<uint16_t>(a);
+        c.found++;
+        c.hit += Coverage::test(cov.executed, pc);
+        if (is_branch(cov, mem, pc)) {
+            c.branches++;
+            c.outcomes += Coverage::test(cov.taken, pc) + Coverage::test(cov.not_taken, pc);
+        }
+    }
+    return c;
+}
+
+// <dir of lcov path>/<name>.asm
+std::string listing_path(const std::string& lcov_path, const std::string& name) {
+    size_t slash = lcov_path.rfind('/');
+    return (slash == std::string::npos ? "" : lcov_path.substr(0, slash + 1)) + name + ".asm";
+}
+
+bool write_listing(const std::string& path, const Coverage& cov, const Memory& mem,
+                   const Range& r, const std::vector<uint8_t>& len) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    char text[Disasm::TEXT_LEN];
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        uint16_t pc = static_cast<uint16_t>(a);
+        if (!len[a] || !mem.loaded_at(pc, Disasm::MAX_LEN)) {
+            if (mem.loaded[pc]) std::fprintf(f, "%04X  %02X\n", pc, mem.bytes[pc]);
+            else                std::fprintf(f, "%04X\n", pc);
+            continue;
+        }
+        mem.decode(pc, text, sizeof(text));
+        std::fprintf(f, "%04X  ", pc);
+        for (int i = 0; i < Disasm::MAX_LEN; i++) {
+            if (i < len[a]) std::fprintf(f, "%02X ", mem.bytes[static_cast<uint16_t>(pc + i)]);
+            else            std::fprintf(f, "   ");
+        }
+        std::fprintf(f, " %s%s\n", text, Coverage::test(cov.executed, pc) ? "" : "   ; never executed");
+    }
+    return std::fclose(f) == 0;
+}
+
+void write_lcov(FILE* f, const std::string& test, const std::string& source, const Coverage& cov,
+                const Memory& mem, const Range& r, const std::vector<uint8_t>& len) {
+    Counts c = count(cov, mem, r, len);
+    std::fprintf(f, "TN:%s\nSF:%s\n", test.c_str(), source.c_str());
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        if (!len[a] || !is_branch(cov, mem, static_cast<uint16_t>(a))) continue;
+        uint16_t pc   = static_cast<uint16_t>(a);
+        uint32_t line = a - r.start + 1;
+        if (Coverage::test(cov.executed, pc)) {
+            std::fprintf(f, "BRDA:%u,0,0,%d\n", line, Coverage::test(cov.taken, pc) ? 1 : 0);
+            std::fprintf(f, "BRDA:%u,0,1,%d\n", line, Coverage::test(cov.not_taken, pc) ? 1 : 0);
+        } else {
+            std::fprintf(f, "BRDA:%u,0,0,-\nBRDA:%u,0,1,-\n", line, line);
+        }
+    }
+    std::fprintf(f, "BRF:%d\nBRH:%d\n", c.branches * 2, c.outcomes);
+    for (uint32_t a = r.start; a <= r.end; a++) {
+        if (len[a])
+            std::fprintf(f, "DA:%u,%d\n", a - r.start + 1,
+                         Coverage::test(cov.executed, static_cast<uint16_t>(a)) ? 1 : 0);
+    }
+    std::fprintf(f, "LF:%d\nLH:%d\nend_of_record\n", c.found, c.hit);
+}
+
+double pct(int n, int d) { return d ? 100.0 * n / d : 0.0; }
+
+void usage() {
+    std::fprintf(stderr,
+        "Usage: coverage_report [options] <file.cov>...\n"
+        "\n"
+        "  -o <file.cov>          Write the merged coverage (runs added up)\n"
+        "  --lcov <file.info>     Write an lcov tracefile, one record per range\n"
+        "  --test <name>          Test name for the lcov TN: lines (default: mal80)\n"
+        "  --range <name=S-E>     Report addresses S-E (hex, inclusive); repeatable.\n"
+        "                         Default: rom=0000-2FFF ram=4000-FFFF\n"
+        "  --image <file[@ADDR]>  Memory the code ran from, raw bytes at hex ADDR\n"
+        "                         (default 0); repeatable.  Finds unexecuted code\n"
+        "                         and writes <name>.asm listings for --lcov.\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string out_path, lcov_path, test = "mal80";
+    std::vector<std::string> inputs;
+    std::vector<Range> ranges;
+    auto mem = std::make_unique<Memory>();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if      (arg == "-o" && i + 1 < argc) out_path = argv[++i];
+        else if (arg == "--lcov" && i + 1 < argc) lcov_path = argv[++i];
+        else if (arg == "--test" && i + 1 < argc) test = argv[++i];
+        else if (arg == "--range" && i + 1 < argc) {
+            Range r;
+            if (!parse_range(argv[++i], r)) { usage(); return 2; }
+            ranges.push_back(r);
+        }
+        else if (arg == "--image" && i + 1 < argc) {
+            if (!mem->load(argv[++i])) return 2;
+        }
+        else if (!arg.empty() && arg[0] == '-') { usage(); return 2; }
+        else inputs.push_back(arg);
+    }
+    if (inputs.empty()) { usage(); return 2; }
+    if (ranges.empty()) ranges = {{"rom", 0x0000, 0x2FFF}, {"ram", 0x4000, 0xFFFF}};
+
+    Coverage total;
+    for (const std::string& path : inputs) {
+        Coverage c;
+        if (!c.load(path)) {
+            std::fprintf(stderr, "Cannot read coverage file %s\n", path.c_str());
+            return 2;
+        }
+        total.merge(c);
+    }
+    if (!out_path.empty() && !total.save(out_path)) {
+        std::fprintf(stderr, "Cannot write %s\n", out_path.c_str());
+        return 2;
+    }
+
+    FILE* lcov = nullptr;
+    if (!lcov_path.empty() && !(lcov = std::fopen(lcov_path.c_str(), "w"))) {
+        std::fprintf(stderr, "Cannot write %s\n", lcov_path.c_str());
+        return 2;
+    }
+
+    std::printf("%u run%s merged from %zu file%s\n\n", total.runs, total.runs == 1 ? "" : "s",
+                inputs.size(), inputs.size() == 1 ? "" : "s");
+    std::printf("%-10s %-9s  %19s  %19s\n", "range", "addresses", "instructions", "branch outcomes");
+    std::vector<uint8_t> len;
+    for (const Range& r : ranges) {
+        discover(total, *mem, r, len);
+        Counts c = count(total, *mem, r, len);
+        std::printf("%-10s %04X-%04X  %6d/%-6d %5.1f%%  %6d/%-6d %5.1f%%\n",
+                    r.name.c_str(), r.start, r.end, c.hit, c.found, pct(c.hit, c.found),
+                    c.outcomes, c.branches * 2, pct(c.outcomes, c.branches * 2));
+        if (!lcov) continue;
+        std::string source = r.name;
+        if (mem->any) {
+            source = listing_path(lcov_path, r.name);
+            if (!write_listing(source, total, *mem, r, len))
+                std::fprintf(stderr, "Cannot write %s\n", source.c_str());
+        }
+        write_lcov(lcov, test, source, total, *mem, r, len);
+    }
+    if (lcov && std::fclose(lcov) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", lcov_path.c_str());
+        return 2;
+    }
+    return 0;
+}
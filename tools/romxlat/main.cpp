@@ -0,0 +1,357 @@
+// tools/romxlat/main.cpp
+// romxlat — ahead-of-time translator for the Level II ROM
+//
+// Run by the Makefile before mal-80 is linked.  Reads the 12KB ROM image and
+// writes a C++ file holding one function per ROM instruction: the opcode's
+// work with its operands, branch targets and return address baked in as
+// constants, the same flag helpers the interpreter uses, and the T_MAIN /
+// T_TAKEN_MAIN cost.  Z80::step() calls these instead of fetching and
+// dispatching while the bus returns exactly these bytes (see RomXlat.hpp).
+//
+// Which addresses get a function:
+//   - control flow: every instruction reachable from the reset, RST and NMI
+//     vectors through jumps, calls and fall-through;
+//   - linear sweep: the bytes flow analysis didn't reach (handlers entered
+//     through the BASIC dispatch tables or JP (HL)) decoded in sequence.
+// Data decoded as code is harmless: it is only ever run if the CPU goes
+// there, and then it is exactly what the interpreter would have done.
+//
+// Unprefixed opcodes only; CB/DD/ED/FD instructions and anything running
+// past 0x2FFF stay with the interpreter.
+//
+// Usage: romxlat <level2.rom> <out.cpp>
+//        A missing ROM writes an empty table (mal-80 then interprets).
+
+#include "../../src/system/Fnv1a.hpp"   // RomXlat::hash() must agree
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static constexpr int ROM_SIZE = 0x3000;
+
+static uint8_t rom[ROM_SIZE];
+
+// ============================================================================
+// DECODING
+// ============================================================================
+static int main_len(uint8_t op) {
+    switch (op) {
+        case 0x01: case 0x11: case 0x21: case 0x31:
+        case 0x22: case 0x2A: case 0x32: case 0x3A:
+        case 0xC3: case 0xCD:
+            return 3;
+        case 0x10: case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+        case 0xD3: case 0xDB:
+            return 2;
+    }
+    if ((op & 0xC7) == 0x06) return 2;               // LD r,n
+    if ((op & 0xC7) == 0xC6) return 2;               // ALU n
+    if ((op & 0xC7) == 0xC2 || (op & 0xC7) == 0xC4) return 3;   // JP cc / CALL cc
+    return 1;
+}
+
+// DD/FD instructions that take an (IX+d) displacement.
+static bool xy_disp(uint8_t op) {
+    if (op == 0x34 || op == 0x35 || op == 0x36) return true;
+    if (op >= 0x70 && op <= 0x77 && op != 0x76) return true;
+    if (op >= 0x40 && op <= 0xBF && (op & 7) == 6 && op != 0x76) return true;
+    return false;
+}
+
+// Full length of the instruction at `pc`, prefixes included.
+static int length(int pc) {
+    uint8_t op = rom[pc];
+    uint8_t nx = pc + 1 < ROM_SIZE ? rom[pc + 1] : 0;
+    switch (op) {
+        case 0xCB: return 2;
+        case 0xED: return (nx & 0xC7) == 0x43 ? 4 : 2;   // LD (nn),rr / LD rr,(nn)
+        case 0xDD:
+        case 0xFD:
+            if (nx == 0xCB) return 4;
+            return 1 + main_len(nx) + (xy_disp(nx) ? 1 : 0);
+    }
+    return main_len(op);
+}
+
+// ============================================================================
+// CONTROL FLOW
+// ============================================================================
+static bool is_code[ROM_SIZE];     // an instruction starts here
+static bool covered[ROM_SIZE];     // byte belongs to a decoded instruction
+
+static void trace(int entry) {
+    std::vector<int> work{entry};
+    while (!work.empty()) {
+        int pc = work.back();
+        work.pop_back();
+        while (pc >= 0 && pc < ROM_SIZE && !is_code[pc]) {
+            int len = length(pc);
+            if (pc + len > ROM_SIZE) break;
+            is_code[pc] = true;
+            for (int i = 0; i < len; i++) covered[pc + i] = true;
+
+            uint8_t  op   = rom[pc];
+            uint16_t nn   = len == 3 ? static_cast<uint16_t>(rom[pc + 1] | rom[pc + 2] << 8) : 0;
+            int      next = pc + len;
+            int      rel  = len == 2 ? next + static_cast<int8_t>(rom[pc + 1]) : 0;
+
+            if (op == 0xC3) { pc = nn; continue; }                       // JP
+            if (op == 0x18) { pc = rel; continue; }                      // JR
+            if (op == 0xC9 || op == 0xE9) break;                         // RET, JP (HL)
+            if (op == 0xED && (rom[pc + 1] == 0x45 || rom[pc + 1] == 0x4D)) break;
+            if ((op == 0xDD || op == 0xFD) && rom[pc + 1] == 0xE9) break;
+            if (op == 0xCD || (op & 0xC7) == 0xC2 || (op & 0xC7) == 0xC4) work.push_back(nn);
+            if (op == 0x10 || (op & 0xE7) == 0x20) work.push_back(rel);
+            if ((op & 0xC7) == 0xC7) work.push_back(op & 0x38);          // RST
+            pc = next;
+        }
+    }
+}
+
+// ============================================================================
+// CODE GENERATION
+// ============================================================================
+static const char* R8[8]  = {"z.reg.b", "z.reg.c", "z.reg.d", "z.reg.e",
+                             "z.reg.h", "z.reg.l", nullptr,   "z.reg.a"};
+static const char* R16[4] = {"z.reg.bc", "z.reg.de", "z.reg.hl", "z.reg.sp"};
+static const char* ALU[8] = {"op_add", "op_adc", "op_sub", "op_sbc",
+                             "op_and", "op_xor", "op_or",  "op_cp"};
+static const char* CC[8]  = {"!z.get_flag(FLAG_Z)", "z.get_flag(FLAG_Z)",
+                             "!z.get_flag(FLAG_C)", "z.get_flag(FLAG_C)",
+                             "!z.get_flag(FLAG_P)", "z.get_flag(FLAG_P)",
+                             "!z.get_flag(FLAG_S)", "z.get_flag(FLAG_S)"};
+
+static std::string hex(unsigned v, int digits) {
+    char buf[8];
+    std::snprintf(buf, sizeof(buf), "0x%0*X", digits, v);
+    return buf;
+}
+
+// 8-bit source operand r: register or (HL).
+static std::string src8(int r) { return R8[r] ? R8[r] : "z.read_mem(z.reg.hl)"; }
+
+// Body of the instruction at pc (after PC and R have been advanced), or ""
+// if it is left to the interpreter.  Mirrors Z80::init_main_table().
+// `cond` is set for instructions whose cost depends on `taken`.
+static std::string body(int pc, bool& cond) {
+    uint8_t     op  = rom[pc];
+    int         len = main_len(op);
+    std::string n   = len >= 2 ? hex(rom[pc + 1], 2) : "";
+    uint16_t    w   = len == 3 ? static_cast<uint16_t>(rom[pc + 1] | rom[pc + 2] << 8) : 0;
+    std::string nn  = hex(w, 4);
+    std::string rel = len == 2 ? hex(static_cast<uint16_t>(pc + 2 + static_cast<int8_t>(rom[pc + 1])), 4) : "";
+    std::string ret = hex(static_cast<uint16_t>(pc + len), 4);
+    int y = (op >> 3) & 7, r = op & 7, p = (op >> 4) & 3;
+    cond = false;
+
+    if (op == 0xCB || op == 0xDD || op == 0xED || op == 0xFD) return "";
+
+    if (op >= 0x40 && op <= 0x7F) {
+        if (op == 0x76) return "z.op_halt();";
+        if (y == 6) return "z.write_mem(z.reg.hl, " + std::string(R8[r]) + ");";
+        return std::string(R8[y]) + " = " + src8(r) + ";";
+    }
+    if (op >= 0x80 && op <= 0xBF) return "z." + std::string(ALU[y]) + "(" + src8(r) + ");";
+    if ((op & 0xC7) == 0xC6) return "z." + std::string(ALU[y]) + "(" + n + ");";
+    if ((op & 0xC7) == 0x06) {
+        if (y == 6) return "z.write_mem(z.reg.hl, " + n + ");";
+        return std::string(R8[y]) + " = " + n + ";";
+    }
+    if ((op & 0xC7) == 0x04 || (op & 0xC7) == 0x05) {
+        const char* f = (op & 1) ? "op_dec" : "op_inc";
+        if (y == 6) return std::string("uint8_t v = z.read_mem(z.reg.hl); z.") + f +
+                           "(v); z.write_mem(z.reg.hl, v);";
+        return std::string("z.") + f + "(" + R8[y] + ");";
+    }
+    if ((op & 0xCF) == 0x01) return std::string(R16[p]) + " = " + nn + ";";
+    if ((op & 0xCF) == 0x09) return std::string("z.op_add16(z.reg.hl, ") + R16[p] + ");";
+    if ((op & 0xCF) == 0x03) return std::string("z.op_inc16(") + R16[p] + ");";
+    if ((op & 0xCF) == 0x0B) return std::string("z.op_dec16(") + R16[p] + ");";
+    if ((op & 0xC7) == 0xC2) return "if (" + std::string(CC[y]) + ") z.reg.pc = " + nn + ";";
+    if ((op & 0xC7) == 0xC4) {
+        cond = true;
+        return "if (" + std::string(CC[y]) + ") { z.push(" + ret + "); z.reg.pc = " + nn +
+               "; taken = true; }";
+    }
+    if ((op & 0xC7) == 0xC0) {
+        cond = true;
+        return "if (" + std::string(CC[y]) + ") { z.reg.pc = z.pop(); taken = true; }";
+    }
+    if ((op & 0xC7) == 0xC7) return "z.push(" + ret + "); z.reg.pc = " + hex(op & 0x38, 4) + ";";
+    if ((op & 0xE7) == 0x20) {
+        static const char* JRCC[4] = {"!z.get_flag(FLAG_Z)", "z.get_flag(FLAG_Z)",
+                                      "!z.get_flag(FLAG_C)", "z.get_flag(FLAG_C)"};
+        cond = true;
+        return "if (" + std::string(JRCC[y - 4]) + ") { z.reg.pc = " + rel + "; taken = true; }";
+    }
+
+    switch (op) {
+        case 0x00: return "z.op_nop();";
+        case 0x02: return "z.write_mem(z.reg.bc, z.reg.a);";
+        case 0x12: return "z.write_mem(z.reg.de, z.reg.a);";
+        case 0x0A: return "z.reg.a = z.read_mem(z.reg.bc);";
+        case 0x1A: return "z.reg.a = z.read_mem(z.reg.de);";
+        case 0x22: return "z.write_mem(" + nn + ", z.reg.hl & 0xFF); z.write_mem(" +
+                          hex(static_cast<uint16_t>(w + 1), 4) + ", z.reg.hl >> 8);";
+        case 0x2A: return "z.reg.hl = z.read_mem(" + nn + ") | (z.read_mem(" +
+                          hex(static_cast<uint16_t>(w + 1), 4) + ") << 8);";
+        case 0x32: return "z.write_mem(" + nn + ", z.reg.a);";
+        case 0x3A: return "z.reg.a = z.read_mem(" + nn + ");";
+        case 0x08: return "z.op_ex_af();";
+        case 0xE3: return "uint16_t val = z.reg.hl; z.reg.hl = z.read_mem(z.reg.sp) | "
+                          "(z.read_mem(z.reg.sp + 1) << 8); z.write_mem(z.reg.sp, val & 0xFF); "
+                          "z.write_mem(z.reg.sp + 1, val >> 8);";
+        case 0xC5: return "z.push(z.reg.bc);";
+        case 0xD5: return "z.push(z.reg.de);";
+        case 0xE5: return "z.push(z.reg.hl);";
+        case 0xF5: return "z.push((static_cast<uint16_t>(z.reg.a) << 8) | z.reg.f);";
+        case 0xC1: return "z.reg.bc = z.pop();";
+        case 0xD1: return "z.reg.de = z.pop();";
+        case 0xE1: return "z.reg.hl = z.pop();";
+        case 0xF1: return "uint16_t af = z.pop(); z.reg.f = af & 0xFF; z.reg.a = af >> 8;";
+        case 0xEB: return "z.op_ex_de_hl();";
+        case 0xD9: return "z.op_exx();";
+        case 0x27: return "z.op_daa();";
+        case 0x2F: return "z.reg.a = ~z.reg.a; z.set_hf(true); z.set_nf(true); z.set_f35(z.reg.a);";
+        case 0x3F: return "bool old_c = z.get_flag(FLAG_C); z.set_hf(old_c); z.set_cf(!old_c); "
+                          "z.set_nf(false); z.set_f35(z.reg.a);";
+        case 0x37: return "z.set_cf(true); z.set_hf(false); z.set_nf(false); z.set_f35(z.reg.a);";
+        case 0x07: return "bool c = z.reg.a & 0x80; z.reg.a = (z.reg.a << 1) | (c ? 1 : 0); "
+                          "z.set_cf(c); z.set_hf(false); z.set_nf(false); z.set_f35(z.reg.a);";
+        case 0x0F: return "bool c = z.reg.a & 0x01; z.reg.a = (z.reg.a >> 1) | (c ? 0x80 : 0); "
+                          "z.set_cf(c); z.set_hf(false); z.set_nf(false); z.set_f35(z.reg.a);";
+        case 0x17: return "z.op_rla();";
+        case 0x1F: return "z.op_rra();";
+        case 0x10: cond = true;
+                   return "z.reg.b--; if (z.reg.b != 0) { z.reg.pc = " + rel + "; taken = true; }";
+        case 0x18: return "z.reg.pc = " + rel + ";";
+        case 0xC3: return "z.reg.pc = " + nn + ";";
+        case 0xE9: return "if (z.reg.hl >= 0xFE00) { std::fprintf(stderr, \"[BADJP] JP (HL)=0x%04X "
+                          "from PC=0x%04X\\n\", z.reg.hl, z.reg.pc); } z.reg.pc = z.reg.hl;";
+        case 0xCD: return std::string(w >= 0xFE00 ? "std::fprintf(stderr, \"[HIGHCALL] CALL " +
+                                                    hex(w, 4) + " from PC=" + ret + "\\n\"); "
+                                                  : "") +
+                          "z.push(" + ret + "); z.reg.pc = " + nn + ";";
+        case 0xC9: return "z.reg.pc = z.pop();";
+        case 0xD3: return "z.bus.write_port(" + n + ", z.reg.a);";
+        case 0xDB: return "z.reg.a = z.bus.read_port(" + n + ");";
+        case 0xF9: return "z.reg.sp = z.reg.hl;";
+        case 0xF3: return "z.op_di();";
+        case 0xFB: return "z.op_ei();";
+    }
+    return "";
+}
+
+static bool write_output(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    return static_cast<bool>(out);
+}
+
+static const char* HEADER =
+    "// Generated by tools/romxlat — do not edit.\n";
+
+static const char* INCLUDES =
+    "#include \"../../src/cpu/RomXlat.hpp\"\n"
+    "#include \"../../src/cpu/z80.hpp\"\n"
+    "#include \"../../src/cpu/Timing.hpp\"\n"
+    "#include \"../../src/system/Bus.hpp\"\n"
+    "#include <cstdio>\n\n";
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: romxlat <level2.rom> <out.cpp>\n";
+        return 2;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "[XLAT] " << argv[1] << " not found — building without ROM translation\n";
+        std::string stub = std::string(HEADER) + "// No ROM at build time: empty table.\n" +
+                           "#include \"../../src/cpu/RomXlat.hpp\"\n\n" +
+                           "const RomXlatImage ROM_XLAT = {0, nullptr, 0};\n";
+        return write_output(argv[2], stub) ? 0 : 1;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() > ROM_SIZE) {
+        std::cerr << "[XLAT] " << argv[1] << " is larger than 12KB\n";
+        return 1;
+    }
+    std::copy(bytes.begin(), bytes.end(), rom);
+
+    // Reset, RST 08h-38h (RST 38h is the IM 1 interrupt), NMI.
+    for (int v = 0x00; v <= 0x38; v += 8) trace(v);
+    trace(0x0066);
+    int flow = 0;
+    for (int pc = 0; pc < ROM_SIZE; pc++) flow += is_code[pc];
+    for (int pc = 0; pc < ROM_SIZE; pc++) {
+        if (covered[pc]) continue;
+        int len = length(pc);
+        if (pc + len > ROM_SIZE) break;
+        is_code[pc] = true;
+        for (int i = 0; i < len; i++) covered[pc + i] = true;
+    }
+
+    std::string fns, table;
+    int count = 0, swept = 0;
+    for (int pc = 0; pc < ROM_SIZE; pc++) {
+        bool cond = false;
+        std::string b;
+        if (is_code[pc] && pc + main_len(rom[pc]) <= ROM_SIZE) b = body(pc, cond);
+        table += (pc % 4 == 0 ? "    " : " ");
+        if (b.empty()) {
+            table += "nullptr,";
+        } else {
+            char name[16];
+            std::snprintf(name, sizeof(name), "x%04X", pc);
+            std::string op  = hex(rom[pc], 2);
+            std::string len = std::to_string(main_len(rom[pc]));
+            fns += "    static int " + std::string(name) + "(Z80& z) {\n";
+            fns += "        fetched(z, " + hex(static_cast<uint16_t>(pc + main_len(rom[pc])), 4) + ");\n";
+            if (cond) fns += "        bool taken = false;\n";
+            fns += "        " + b + "\n";
+            fns += cond ? "        return T_MAIN[" + op + "] + (taken ? T_TAKEN_MAIN[" + op + "] : 0);\n"
+                        : "        return T_MAIN[" + op + "];\n";
+            fns += "    }\n";
+            table += "O::" + std::string(name) + ",";
+            count++;
+        }
+        if (pc % 4 == 3) table += "\n";
+    }
+    for (int pc = 0; pc < ROM_SIZE; pc++) swept += is_code[pc];
+    swept -= flow;
+
+    char summary[256];
+    std::snprintf(summary, sizeof(summary),
+                  "// %s: %d instructions decoded, %d by control flow from the vectors\n"
+                  "// and %d by linear sweep; %d translated (unprefixed opcodes).\n\n",
+                  argv[1], flow + swept, flow, swept, count);
+
+    std::string text = std::string(HEADER) + summary + INCLUDES;
+    text += "// Friend of Z80: each function runs one ROM instruction exactly as the\n"
+            "// interpreter would, with the fetch already done at generation time.\n"
+            "struct RomXlatOps {\n"
+            "    // The opcode's M1 cycle: refresh counter and PC past the operands.\n"
+            "    static void fetched(Z80& z, uint16_t next) {\n"
+            "        z.reg.r  = (z.reg.r & 0x80) | ((z.reg.r + 1) & 0x7F);\n"
+            "        z.reg.pc = next;\n"
+            "    }\n\n";
+    text += fns;
+    text += "};\n\nusing O = RomXlatOps;\n\n";
+    text += "static const Z80::XlatFn TABLE[ROM_SIZE] = {\n" + table + "};\n\n";
+    char tail[128];
+    std::snprintf(tail, sizeof(tail), "const RomXlatImage ROM_XLAT = {0x%016llXull, TABLE, %d};\n",
+                  static_cast<unsigned long long>(fnv1a(rom, ROM_SIZE)), count);
+    text += tail;
+
+    if (!write_output(argv[2], text)) {
+        std::cerr << "[XLAT] cannot write " << argv[2] << "\n";
+        return 1;
+    }
+    std::cout << "[XLAT] " << argv[1] << ": " << count << " instructions translated → "
+              << argv[2] << "\n";
+    return 0;
+}